@@ -24,12 +24,24 @@
 #include <unistd.h>
 #include <stdarg.h>
 #include <ctype.h>
+#include <setjmp.h>
 
 #include "print.h"
+#include "input.h"
 #include "field.h"
+#include "arena.h"
+#include "idents.h"
 #include "data.h"
 #include "settings.h"
 #include "out.h"
+#include "tape.h"
+#include "chunk.h"
+#include "cache.h"
+#include "server.h"
+#include "batch.h"
+#include "libamdasm.h"
+#include "lib.h"
+#include "context.h"
 
 #define VERSION "1.0.2"
 
@@ -40,24 +52,24 @@
 #define DBG_VERBOSE 0x0010
 
 extern int yydebug;
-extern int yy_flex_debug;
 
-extern FILE *yyin;
-extern int yyparse();
-extern int yylex();
-extern char *yytext;
+extern int yyparse(Context* ctx);
 extern void yyerror(const char* msg);
-extern "C" {
-	int yywrap();
-}
+extern void yyerror(Context* ctx, const char* msg);
 
+extern Context* parse_options(int argc, char* argv[], jmp_buf* bail=0);
 extern int parse_file(int phase);
+extern void scan_input(Context* ctx, Input* in, char marker);
+extern void scan_tape(Context* ctx, int first, int last, bool whole);
+extern void scan_end(Context* ctx);
+extern void scan_free(Context* ctx);
 extern char* copystr(const char* str);
 extern int decimal_bits(int value);
 extern void print_const(int sz, int fmt, int value);
 extern void verbose(const char* fmt, ...);
 extern bool overlay(const Fdecl& fd, char* line);
 extern int internal_error(const char* at, int line);
+extern void fatal(int code);
 extern char* bin2str(int value, char* buf);
 
 #endif
@@ -20,16 +20,71 @@
 #include "amdasm.h"
 #include "data.h"
 
-static Fdecl vdecl;
-static Sub*  vdef;
-static Lineout* outline;
-static int ffcnt, vsize;
+/* single pass mode: a label and an EQU of the same name would resolve
+ * differently in phases 2a and 2b, so reject them here */
+static void enter_label(Context* ctx, const Ident* name, bool entry)
+{
+    Symbol* s = ctx->symtab->Lookup(name);
+    if (s && s->IsA()==ISA_EQU)
+        yyerror("Label and EQU of same name in single pass mode");
+    ctx->labels->Enter(new Label(name->text, ctx->set->LocPtr(), entry));
+}
+
+static void enter_equ(Context* ctx, const Ident* name, const Fdecl& val)
+{
+    if (val.fmt & F_FWD) {
+        yyerror("Undeclared NAME");
+        return;
+    }
+    if (ctx->labels->Lookup(name))
+        yyerror("Label and EQU of same name in single pass mode");
+    Equ* vequ = new Equ(name->text, val);
+    ctx->symtab->Enter(vequ);
+    if (ctx->set->IsDebug(DBG_DEFS))
+        vequ->Debug();
+}
+
+/* substitute VFS argument, or defer it if it is a forward reference */
+static void subst_arg(Context* ctx, const Fdecl& arg)
+{
+    if (arg.fmt & F_FWD)
+        ctx->outline->DeferArg(ctx->fwdname, arg);
+    else
+        ctx->outline->SubstArg(arg);
+}
+
+/* a forward reference may only be offset by a constant */
+static int fwd_expr(const Fdecl& l, const Fdecl& r, bool left, bool right)
+{
+    bool fl = (l.fmt & F_FWD) != 0;
+    bool fr = (r.fmt & F_FWD) != 0;
+    if (!fl && !fr) return 0;
+    if ((fl && fr) || (fl && !left) || (fr && !right)) {
+        yyerror("Invalid use of forward reference");
+        return 0;
+    }
+    return F_FWD;
+}
 %}
 
+%define api.pure full
+%parse-param {Context* ctx}
+%lex-param {Context* ctx}
+
+%code requires {
+class Context;
+struct Ident;
+}
+
+%code provides {
+extern int yylex(YYSTYPE* lval, Context* ctx);
+}
+
 %union
 {
 	int   fmt;
 	char* str;
+	const Ident* name;
 	Fdecl fdecl;
 }
 
@@ -43,17 +98,17 @@ static int ffcnt, vsize;
 %token SUB
 %token XOPT
 %token WORD
-%token <str> NAME ENTRY LABEL
+%token <name> NAME ENTRY LABEL
 %token COMMA AMPERSAND COLON
 %token PERCENT DOLLAR
 %token LPAREN RPAREN
-%token DEFMARK SRCMARK1 SRCMARK2
+%token DEFMARK SRCMARK1 SRCMARK2 SRCCHUNK
 %token COLS
 
 %left PLUS MINUS TIMES SLASH
 
 %type <fdecl> constant expr expr2
-%type <str> label
+%type <name> label
 
 %%
 
@@ -62,6 +117,8 @@ start
 :	DEFMARK deffile
 |	SRCMARK1 srcfile1
 |	SRCMARK2 srcfile2
+|	SRCCHUNK          { ctx->outline = 0; }
+    src_stmts2        /* part of SRC, see Chunk */
 ;
 
 deffile
@@ -83,38 +140,38 @@ def_stmts
 
 printctrl_stmt
 :   NL
-|	TITLE           { p->SetTitle($1); } NL
-|	LIST NL         { p->List(); }
-|	NOLIST NL       { p->Nolist(); }
-|	SPACE NUMBER NL { p->Space($2.value); }
-|	EJECT NL        { p->Eject(); }
+|	TITLE           { ctx->p->SetTitle($1); } NL
+|	LIST NL         { ctx->p->List(); }
+|	NOLIST NL       { ctx->p->Nolist(); }
+|	SPACE NUMBER NL { ctx->p->Space($2.value); }
+|	EJECT NL        { ctx->p->Eject(); }
 ;
 
 equ_stmt
-:	label EQU expr	{ Equ* vequ = new Equ($1, $3);
-                      symtab->Enter(vequ);
-                      if (set->IsDebug(DBG_DEFS))
+:	label EQU expr	{ Equ* vequ = new Equ($1->text, $3);
+                      ctx->symtab->Enter(vequ);
+                      if (ctx->set->IsDebug(DBG_DEFS))
                         vequ->Debug();
                     }
 ;
 
 microword_stmt
-:   label DEF 		{ vdef = new Def($1); }
-	fieldlist   	{ symtab->Enter(vdef);
-                      if (set->IsDebug(DBG_DEFS))
-                        vdef->Debug("DEF");
-                      if (vdef->Bitsize() != set->WordSize()) {
+:   label DEF 		{ ctx->vdef = new Def($1->text); }
+	fieldlist   	{ ctx->symtab->Enter(ctx->vdef);
+                      if (ctx->set->IsDebug(DBG_DEFS))
+                        ctx->vdef->Debug("DEF");
+                      if (ctx->vdef->Bitsize() != ctx->set->WordSize()) {
                         yyerror("DEF size does not match WORD size");
-                        vdef->Debug("DEF");
+                        ctx->vdef->Debug("DEF");
                         YYERROR; }
                     }
 ;
 
 subword_stmt
-:   label SUB 		{ vdef = new Sub($1); }
-	fieldlist   	{ symtab->Enter(vdef);
-                      if (set->IsDebug(DBG_DEFS))
-                        vdef->Debug("SUB");
+:   label SUB 		{ ctx->vdef = new Sub($1->text); }
+	fieldlist   	{ ctx->symtab->Enter(ctx->vdef);
+                      if (ctx->set->IsDebug(DBG_DEFS))
+                        ctx->vdef->Debug("SUB");
                     }
 ;
 
@@ -126,7 +183,7 @@ label
 
 def_stmt
 :   printctrl_stmt
-|	WORD NUMBER NL  { set->SetWordSize($2.value); }
+|	WORD NUMBER NL  { ctx->set->SetWordSize($2.value); }
 |   equ_stmt NL
 |	microword_stmt NL
 |   subword_stmt NL
@@ -135,18 +192,18 @@ def_stmt
 ;
 
 cols_extension
-:   COLS cols_list  { int w = set->WordSize(), c = columns->Size();
+:   COLS cols_list  { int w = ctx->set->WordSize(), c = ctx->columns->Size();
                       if (w != c) {
                         yyerror("COLS size does not match WORD size");
-                        if (w>c) columns->AddColumn(w-c);
+                        if (w>c) ctx->columns->AddColumn(w-c);
                         YYERROR;
                       }
                     }
 ;
 
 cols_list
-:   NUMBER                  { columns->AddColumn($1.value); }
-|   NUMBER COMMA cols_list  { columns->AddColumn($1.value); }
+:   NUMBER                  { ctx->columns->AddColumn($1.value); }
+|   NUMBER COMMA cols_list  { ctx->columns->AddColumn($1.value); }
 ;
 
 fieldlist
@@ -155,15 +212,15 @@ fieldlist
 ;
 
 field
-:	DCFIELD				{ if (!vdef->AddField(new Field($1))) YYERROR; }
-|	VARFIELD 			{ vdecl = $1; }
+:	DCFIELD				{ if (!ctx->vdef->AddField(new Field($1))) YYERROR; }
+|	VARFIELD 			{ ctx->vdecl = $1; }
 	opt_vattr
-	opt_defval			{ if (!vdef->AddField(new VField(vdecl))) YYERROR; }
-|	constant			{ vdecl = $1;
-                          if (!(vdecl.fmt & F_MASK)) vdecl.fmt |= F_DEC;
-                          if (!vdef->AddField(new CField(vdecl))) YYERROR;
+	opt_defval			{ if (!ctx->vdef->AddField(new VField(ctx->vdecl))) YYERROR; }
+|	constant			{ ctx->vdecl = $1;
+                          if (!(ctx->vdecl.fmt & F_MASK)) ctx->vdecl.fmt |= F_DEC;
+                          if (!ctx->vdef->AddField(new CField(ctx->vdecl))) YYERROR;
                         }
-|	NAME				{ if (!vdef->Include($1)) YYERROR; }
+|	NAME				{ if (!ctx->vdef->Include($1)) YYERROR; }
 ;
 
 constant
@@ -174,10 +231,10 @@ constant
 
 expr
 :	constant			{ $$ = $1; }
-|	NAME				{ if (!CField::ResolveDecimal($1, &$$) && 
-                              !symtab->LookupValue($1, &$$)) YYERROR;
+|	NAME				{ if (!CField::ResolveDecimal($1->text, &$$) && 
+                              !ctx->symtab->LookupValue($1, &$$)) YYERROR;
                         }
-|	DOLLAR				{ $$.value = set->LocPtr(); $$.sz = 0; }
+|	DOLLAR				{ $$.Set(F_DEC, 0, ctx->set->LocPtr()); }
 |	expr PLUS expr		{ $$.value = $1.value + $3.value; $$.sz = 0; } 
 |	expr MINUS expr		{ $$.value = $1.value - $3.value; $$.sz = 0; } 
 |	expr TIMES expr		{ $$.value = $1.value * $3.value; $$.sz = 0; } 
@@ -186,39 +243,39 @@ expr
 
 opt_vattr
 :	/*empty*/
-|	opt_vattr PERCENT   { vdecl.fmt |= FA_RITE; }
-|	opt_vattr TIMES		{ vdecl.fmt |= FA_INV; }
-|	opt_vattr MINUS		{ vdecl.fmt |= FA_NEG; }
-|	opt_vattr COLON		{ vdecl.fmt |= FA_TRNC; }
-|	opt_vattr DOLLAR	{ vdecl.fmt |= FA_PAGE; }
-|	opt_vattr XOPT		{ vdecl.fmt |= FA_XINI; }
+|	opt_vattr PERCENT   { ctx->vdecl.fmt |= FA_RITE; }
+|	opt_vattr TIMES		{ ctx->vdecl.fmt |= FA_INV; }
+|	opt_vattr MINUS		{ ctx->vdecl.fmt |= FA_NEG; }
+|	opt_vattr COLON		{ ctx->vdecl.fmt |= FA_TRNC; }
+|	opt_vattr DOLLAR	{ ctx->vdecl.fmt |= FA_PAGE; }
+|	opt_vattr XOPT		{ ctx->vdecl.fmt |= FA_XINI; }
 ;
 
 opt_defval
 :	/*empty*/
-|	DEFFMT opt_vmod     { vdecl.fmt |= $1; }
-|	constant opt_vmod   { vdecl.value = $1.value; vdecl.fmt |= ($1.fmt|FA_VAL); }
+|	DEFFMT opt_vmod     { ctx->vdecl.fmt |= $1; }
+|	constant opt_vmod   { ctx->vdecl.value = $1.value; ctx->vdecl.fmt |= ($1.fmt|FA_VAL); }
 ;
 
 opt_vmod
 :	/*empty*/
-|	opt_vmod PERCENT    { vdecl.fmt |= FM_RITE; }
-|	opt_vmod TIMES	    { vdecl.fmt |= FM_INV; }
-|	opt_vmod MINUS	    { vdecl.fmt |= FM_NEG; }
-|	opt_vmod COLON	    { vdecl.fmt |= FM_TRNC; }
+|	opt_vmod PERCENT    { ctx->vdecl.fmt |= FM_RITE; }
+|	opt_vmod TIMES	    { ctx->vdecl.fmt |= FM_INV; }
+|	opt_vmod MINUS	    { ctx->vdecl.fmt |= FM_NEG; }
+|	opt_vmod COLON	    { ctx->vdecl.fmt |= FM_TRNC; }
 ;
 
 /***************************************************/
 
 srcfile1
 :	src_stmts1
-	END                 { set->ResetLocPtr(); }
+	END                 { ctx->set->ResetLocPtr(); }
     emptylines
 ;
 
 src_stmts1
 :	/*empty*/
-|	src_stmts1 src_stmt1
+|	src_stmts1 src_stmt1 { if (yychar == YYEMPTY) Chunk::Mark(ctx); }
 ;
 
 src_stmt1
@@ -229,16 +286,16 @@ src_stmt1
 |	SPACE NUMBER NL
 |	EJECT NL
 |   equ_stmt1 NL
-|   ORG expr NL         { set->SetLocPtr($2.value); }
-|	RES expr NL         { set->IncLocPtr($2.value); }
-|	ALIGN expr NL       { set->AlignLocPtr($2.value); }
+|   ORG expr NL         { ctx->set->SetLocPtr($2.value); }
+|	RES expr NL         { ctx->set->IncLocPtr($2.value); }
+|	ALIGN expr NL       { ctx->set->AlignLocPtr($2.value); }
 |	opt_label1 
-    exec_stmt1 NL       { set->IncLocPtr(1); }
+    exec_stmt1 NL       { ctx->set->IncLocPtr(1); }
 ;
 
 label1
-:	LABEL		        { labels->Enter(new Label($1, set->LocPtr(), false)); }
-|	ENTRY		        { labels->Enter(new Label($1, set->LocPtr(), true)); }
+:	LABEL		        { ctx->labels->Enter(new Label($1->text, ctx->set->LocPtr(), false)); }
+|	ENTRY		        { ctx->labels->Enter(new Label($1->text, ctx->set->LocPtr(), true)); }
 ;
 
 opt_label1
@@ -247,9 +304,9 @@ opt_label1
 ;
 
 equ_stmt1
-:	label EQU expr	    { Equ* vequ = new Equ($1, $3);
-                          symtab->Enter(vequ);
-                          if (set->IsDebug(DBG_DEFS))
+:	label EQU expr	    { Equ* vequ = new Equ($1->text, $3);
+                          ctx->symtab->Enter(vequ);
+                          if (ctx->set->IsDebug(DBG_DEFS))
                             vequ->Debug();
                         }
 ;
@@ -301,9 +358,9 @@ expr1
 /****************************************************************************/
 
 srcfile2
-:	/*empty*/           { outline = 0; }
+:	/*empty*/           { ctx->outline = 0; }
     src_stmts2
-	END
+	END                 { if (ctx->set->SinglePass()) Fixup::ResolveAll(); }
     emptylines
 ;
 
@@ -315,32 +372,40 @@ src_stmts2
 src_stmt2
 :   printctrl_stmt
 |   equ_stmt2 NL
-|   ORG expr NL         { set->SetLocPtr($2.value); }
-|	RES expr NL         { set->IncLocPtr($2.value); }
-|	ALIGN expr NL       { set->AlignLocPtr($2.value); }
-|	opt_label2 exec_stmt NL { set->IncLocPtr(1); }
+|   ORG expr NL         { ctx->set->SetLocPtr($2.value); }
+|	RES expr NL         { ctx->set->IncLocPtr($2.value); }
+|	ALIGN expr NL       { ctx->set->AlignLocPtr($2.value); }
+|	opt_label2 exec_stmt NL { ctx->set->IncLocPtr(1); }
 ;
 
 equ_stmt2
-:	label EQU expr2	    { if (symtab->LookupValue($1, &vdecl)) {
-                            if (vdecl.value != $3.value)
+:	label EQU expr2	    { if (ctx->set->SinglePass())
+                            enter_equ(ctx, $1, $3);
+                          else if (ctx->symtab->LookupValue($1, &ctx->vdecl)) {
+                            if (ctx->vdecl.value != $3.value)
                               yyerror("Symbol value changed between phases");
                           }
                         }
 ;
 
+label2
+:	LABEL		        { if (ctx->set->SinglePass()) enter_label(ctx, $1, false); }
+|	ENTRY		        { if (ctx->set->SinglePass()) enter_label(ctx, $1, true); }
+;
+
 opt_label2
 :	/*empty*/
-|	label
+|	label2
 ;
 
 exec_stmt
-:	FF                  { outline = new Lineout(); ffcnt = 0; }
-    fffieldlist2        { if (ffcnt != set->WordSize())
+:	FF                  { ctx->outline = new Lineout(); ctx->ffcnt = 0; }
+    fffieldlist2        { if (ctx->ffcnt != ctx->set->WordSize())
                             yyerror("FF length does not match WORD size");
-                          outline = 0;
+                          ctx->outline = 0;
+                          Output::Stream();
                         }
-|	overlayformat_list2 { outline = 0; }
+|	overlayformat_list2 { ctx->outline = 0; Output::Stream(); }
 ;
 
 fffieldlist2
@@ -349,66 +414,81 @@ fffieldlist2
 ;
 
 fffield2
-:	DCFIELD				{ Field xf($1, ffcnt);
-                          if (!outline->SubstField(&xf)) YYERROR;
-                          ffcnt += $1.sz;
+:	DCFIELD				{ if (!ctx->outline->SubstDC($1, ctx->ffcnt)) YYERROR;
+                          ctx->ffcnt += $1.sz;
                         }
-|   NAME LPAREN         { if (CField::ResolveDecimal($1, &vdecl))
-                            vsize = vdecl.value;
+|   NAME LPAREN         { if (CField::ResolveDecimal($1->text, &ctx->vdecl))
+                            ctx->vsize = ctx->vdecl.value;
                           else YYERROR;
                         }
-    expr2 RPAREN        { $4.sz = vsize;
-                          CField xc($4, ffcnt);
-                            if (!outline->SubstField(&xc)) YYERROR;
-                            ffcnt += vsize;
+    expr2 RPAREN        { $4.sz = ctx->vsize;
+                          if ($4.fmt & F_FWD) {
+                            if (!ctx->outline->DeferField(ctx->fwdname, $4, ctx->ffcnt)) YYERROR;
+                          } else if (!ctx->outline->SubstField($4, ctx->ffcnt)) YYERROR;
+                          ctx->ffcnt += ctx->vsize;
                         }
 |	constant			{ if ($1.sz == 0) {
                             yyerror("Size of constant undefined"); YYERROR;
                           }
-                          CField xc($1, ffcnt);
-                          if (!outline->SubstField(&xc)) YYERROR;
-                          ffcnt += $1.sz;
+                          if (!ctx->outline->SubstField($1, ctx->ffcnt)) YYERROR;
+                          ctx->ffcnt += $1.sz;
                         }
-|	NAME				{ if (CField::ResolveDecimal($1, &vdecl) ||
-                              symtab->LookupValue($1, &vdecl, true) ||
-                              labels->LookupValue($1, &vdecl, false)) {
-                            CField xc(vdecl, ffcnt);
-                            if (!outline->SubstField(&xc)) YYERROR;
-                            ffcnt += vdecl.sz;
+|	NAME				{ if (Fixup::IsForward($1)) {
+                            yyerror("Forward reference requires size in single pass mode");
+                            YYERROR;
+                          }
+                          if (CField::ResolveDecimal($1->text, &ctx->vdecl) ||
+                              ctx->symtab->LookupValue($1, &ctx->vdecl, true) ||
+                              ctx->labels->LookupValue($1, &ctx->vdecl, false)) {
+                            if (!ctx->outline->SubstField(ctx->vdecl, ctx->ffcnt)) YYERROR;
+                            ctx->ffcnt += ctx->vdecl.sz;
                           } else YYERROR;
                         }
-|   error COMMA
+|   error               { if (ctx->Worker()) ctx->failed = true; }
+    COMMA               /* a worker would recover beyond its chunk */
 ;
 
 overlayformat2
-:	NAME                { if (outline == 0) outline = new Lineout(); 
-                          outline->SetOverlayFormat($1);
+:	NAME                { if (ctx->outline == 0) ctx->outline = new Lineout(); 
+                          ctx->outline->SetOverlayFormat($1);
                         }
     opt_vfslist2        
 ;
 
 overlayformat_list2
-:	overlayformat2      { outline->DebugSubst(SUB_CURMAP); }
-|	overlayformat_list2 AMPERSAND overlayformat2 { outline->DebugSubst(SUB_CURMAP); }
+:	overlayformat2      { ctx->outline->DebugSubst(SUB_CURMAP); }
+|	overlayformat_list2 AMPERSAND overlayformat2 { ctx->outline->DebugSubst(SUB_CURMAP); }
 ;
 
 opt_vfslist2
-:	/*empty*/           { outline->SkipArg(); }
-|	expr2               { outline->SubstArg($1); }
-|	opt_vfslist2 COMMA expr2 { outline->SubstArg($3); }
-|	opt_vfslist2 COMMA  { outline->SkipArg(); }
+:	/*empty*/           { ctx->outline->SkipArg(); }
+|	expr2               { subst_arg(ctx, $1); }
+|	opt_vfslist2 COMMA expr2 { subst_arg(ctx, $3); }
+|	opt_vfslist2 COMMA  { ctx->outline->SkipArg(); }
 ;
 
 expr2
 :	constant            { $$ = $1; }
-|	NAME				{ if (!CField::ResolveDecimal($1, &$$))
-                            outline->GetNameArg($1, &$$);
+|	NAME				{ if (CField::ResolveDecimal($1->text, &$$))
+                            ;
+                          else if (!ctx->outline && ctx->set->SinglePass()) {
+                            /* EQU: resolve like phase 2a */
+                            if (!ctx->symtab->LookupValue($1, &$$)) YYERROR;
+                          } else if (Fixup::IsForward($1)) {
+                            /* before the lookahead may flush the line */
+                            ctx->fwdname = $1;
+                            ctx->fwdline = ctx->p->Lineno();
+                            delete[] ctx->fwdtext;
+                            ctx->fwdtext = copystr(ctx->p->Linebuf());
+                            $$.Set(F_FWD, 0, 0);
+                          } else
+                            ctx->outline->GetNameArg($1, &$$);
                         }
-|	DOLLAR				{ $$.Set(F_DEC, 0, outline->LocPtr()); }
-|	expr2 PLUS expr2	{ $$.Set(F_DEC, 0, $1.value + $3.value); } 
-|	expr2 MINUS expr2	{ $$.Set(F_DEC, 0, $1.value - $3.value); } 
-|	expr2 TIMES expr2	{ $$.Set(F_DEC, 0, $1.value * $3.value); } 
-|	expr2 SLASH expr2	{ $$.Set(F_DEC, 0, $1.value / $3.value); } 
+|	DOLLAR				{ $$.Set(F_DEC, 0, ctx->outline ? ctx->outline->LocPtr() : ctx->set->LocPtr()); }
+|	expr2 PLUS expr2	{ $$.Set(F_DEC|fwd_expr($1, $3, true, true), 0, $1.value + $3.value); } 
+|	expr2 MINUS expr2	{ $$.Set(F_DEC|fwd_expr($1, $3, true, false), 0, $1.value - $3.value); } 
+|	expr2 TIMES expr2	{ $$.Set(F_DEC|fwd_expr($1, $3, false, false), 0, $1.value * $3.value); } 
+|	expr2 SLASH expr2	{ $$.Set(F_DEC|fwd_expr($1, $3, false, false), 0, $1.value / $3.value); } 
 ;
 
 %%
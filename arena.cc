@@ -0,0 +1,76 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "amdasm.h"
+
+Arena::Arena()
+    : blocks(0), avail(0), left(0)
+{}
+
+Arena::~Arena()
+{
+    Release();
+}
+
+/* n bytes, aligned for a pointer or a Limb */
+void* Arena::Alloc(int n)
+{
+    n = (n + sizeof(Limb)-1) & ~(sizeof(Limb)-1);
+    if (n > left) {
+        int bs = n > ARENA_BLOCKSIZE ? n : ARENA_BLOCKSIZE;
+        char* b = new char[sizeof(Limb) + bs];
+        *(char**)b = blocks;
+        blocks = b;
+        avail = b + sizeof(Limb);
+        left = bs;
+    }
+    char* p = avail;
+    avail += n;
+    left -= n;
+    return p;
+}
+
+char* Arena::Copy(const char* s, int len)
+{
+    char* p = (char*)Alloc(len+1);
+    memcpy(p, s, len);
+    p[len] = '\0';
+    return p;
+}
+
+/* adopt the blocks of other, e.g. the lines of a phase 2b worker */
+void Arena::Take(Arena* other)
+{
+    if (!other->blocks) return;
+    char* b = other->blocks;
+    while (*(char**)b) b = *(char**)b;
+    *(char**)b = blocks;
+    blocks = other->blocks;
+    other->blocks = other->avail = 0;
+    other->left = 0;
+}
+
+void Arena::Release()
+{
+    while (blocks) {
+        char* b = blocks;
+        blocks = *(char**)b;
+        delete[] b;
+    }
+    avail = 0;
+    left = 0;
+}
@@ -0,0 +1,41 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+/* Bump allocation for objects which live as long as their owner, like
+ * identifiers or generated lines. Nothing is freed singly; the blocks
+ * go away with the arena. */
+#define ARENA_BLOCKSIZE 8192
+class Arena
+{
+protected:
+    char* blocks;       /* chained through the first pointer */
+    char* avail;
+    int left;
+public:
+    Arena();
+    ~Arena();
+
+    void* Alloc(int n);
+    char* Copy(const char* s, int len);
+    void Take(Arena* other);
+    void Release();
+};
+
+#endif
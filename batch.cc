@@ -0,0 +1,277 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "amdasm.h"
+#ifdef _WIN32
+#include <io.h>
+#include <direct.h>
+#endif
+
+#define BATCH_MAXARGS 256
+
+/* state shared by the worker threads */
+struct JobPool
+{
+    pthread_mutex_t lock;
+    Batch** jobs;
+    int n, next;
+};
+
+Batch::Batch(int ln, Context* c)
+    : next(0), line(ln), cx(c), owner(0), status(0), ready(false)
+{
+    pthread_mutex_init(&lock, 0);
+    pthread_cond_init(&done, 0);
+    if (cx) cx->job = this;
+}
+
+Batch::~Batch()
+{
+    ctx = cx;
+    delete cx;
+    ctx = 0;
+    pthread_cond_destroy(&done);
+    pthread_mutex_destroy(&lock);
+}
+
+/* one job per line: arguments as on the command line, separated by
+ * blanks, or in double quotes; ';' or '#' starts a comment */
+Batch* Batch::read(const char* file)
+{
+    Input* in = Input::Open(file);
+    if (in == 0) {
+        fprintf(stderr,"*** File %s does not exist\n", file);
+        exit(1);
+    }
+
+    Context* cur = ctx;
+    Batch* first = 0;
+    Batch* last = 0;
+    char* p = in->Buffer();
+    char* end = p + in->Size();
+    for (int ln = 1; p < end; ln++) {
+        char* eol = (char*)memchr(p, '\n', end - p);
+        if (eol == 0) eol = end;
+        *eol = '\0';
+
+        char* argv[BATCH_MAXARGS+2];
+        int argc = 0;
+        char* s = p;
+        argv[argc++] = (char*)"amdasm";
+        p = eol + 1;
+        for (;;) {
+            while (isspace(*s)) s++;
+            if (*s == '\0' || *s == ';' || *s == '#') break;
+            if (argc > BATCH_MAXARGS) {
+                fprintf(stderr,"*** %s:%d: Too many arguments\n", file, ln);
+                exit(1);
+            }
+            if (*s == '"') {
+                argv[argc++] = ++s;
+                while (*s && *s != '"') s++;
+            } else {
+                argv[argc++] = s;
+                while (*s && !isspace(*s)) s++;
+            }
+            if (*s) *s++ = '\0';
+        }
+        if (argc == 1) continue;
+        argv[argc] = 0;
+
+        /* bad arguments: usage() returns here */
+        jmp_buf env;
+        Context* c = 0;
+        optind = 1;
+        if (setjmp(env) == 0) {
+            c = parse_options(argc, argv, &env);
+            c->bailout = 0;
+        } else {
+            delete ctx;
+            ctx = 0;
+        }
+        Batch* b = new Batch(ln, c);
+        if (c == 0) b->status = 2;
+        if (last) last->next = b;
+        else first = b;
+        last = b;
+    }
+    ctx = cur;
+    return first;
+}
+
+/* owner: the other jobs of the DEF file may go on. Also called when
+ * the job ends, in case it failed in phase 1 */
+void Batch::Ready()
+{
+    pthread_mutex_lock(&lock);
+    ready = true;
+    pthread_cond_broadcast(&done);
+    pthread_mutex_unlock(&lock);
+}
+
+/* wait for phase 1 of the owner */
+void Batch::wait()
+{
+    pthread_mutex_lock(&owner->lock);
+    while (!owner->ready)
+        pthread_cond_wait(&owner->done, &owner->lock);
+    pthread_mutex_unlock(&owner->lock);
+}
+
+void Batch::run()
+{
+    if (cx == 0) return;
+    if (owner) wait();
+
+    jmp_buf env;
+    ctx = cx;
+    cx->bailout = &env;
+
+    /* fatal() returns here with the exit code */
+    status = setjmp(env);
+    if (status == 0) {
+        int errors = cx->Run();
+        verbose("*** Finished %s: Errors = %d\n", cx->set->SrcFile(), errors);
+        status = errors ? 1 : 0;
+    }
+    cx->bailout = 0;
+    ctx = 0;
+    Ready();
+}
+
+void* Batch::worker(void* arg)
+{
+    JobPool* pool = (JobPool*)arg;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        Batch* b = pool->next < pool->n ? pool->jobs[pool->next++] : 0;
+        pthread_mutex_unlock(&pool->lock);
+        if (b == 0) break;
+        b->run();
+    }
+    return 0;
+}
+
+/* run jobs on a pool of threads */
+void Batch::pool(Batch** jobs, int n, int threads)
+{
+    if (threads > n) threads = n;
+    if (threads < 1) return;
+    pthread_t* tids = new pthread_t[threads];
+
+    JobPool pool;
+    pthread_mutex_init(&pool.lock, 0);
+    pool.jobs = jobs;
+    pool.n = n;
+    pool.next = 0;
+    for (int i=0; i<threads; i++)
+        if (pthread_create(&tids[i], 0, worker, &pool))
+            internal_error(__FILE__, __LINE__);
+    for (int i=0; i<threads; i++)
+        pthread_join(tids[i], 0);
+    pthread_mutex_destroy(&pool.lock);
+    delete[] tids;
+}
+
+/* a private directory for the caches of the batch */
+static bool make_tmpdir(char* name)
+{
+#ifndef _WIN32
+    strcpy(name, "/tmp/amdasmXXXXXX");
+    return mkdtemp(name) != 0;
+#else
+    const char* tmp = getenv("TEMP");
+    sprintf(name, "%.200s\\amdasmXXXXXX", tmp ? tmp : ".");
+    return _mktemp(name) != 0 && _mkdir(name) == 0;
+#endif
+}
+
+/* returns the highest exit code of all jobs */
+int Batch::Run(Context* cx)
+{
+    const char* file = cx->set->BatchFile();
+    Batch* jobs = read(file);
+    Batch* b;
+    int n = 0;
+    for (b = jobs; b; b = b->next) n++;
+
+    /* the first job of a DEF file parses it, the others use its result */
+    char tmpdir[256];
+    bool hasdir = false;
+    Batch** owners = new Batch*[n];
+    Batch** others = new Batch*[n];
+    int nowners = 0, nothers = 0;
+    for (b = jobs; b; b = b->next) {
+        if (b->cx == 0) continue;
+        Settings* s = b->cx->set;
+        for (Batch* o = jobs; o != b; o = o->next)
+            if (o->cx && o->owner == 0 && !strcmp(o->cx->set->DefFile(), s->DefFile())) {
+                b->owner = o;
+                break;
+            }
+        if (b->owner) {
+            if (s->CacheFile() == 0)
+                s->SetCacheFile(b->owner->cx->set->CacheFile());
+            others[nothers++] = b;
+            continue;
+        }
+        if (s->CacheFile() == 0) {
+            if (!hasdir && !make_tmpdir(tmpdir)) {
+                fprintf(stderr,"*** Cannot create directory %s\n", tmpdir);
+                exit(1);
+            }
+            hasdir = true;
+            char name[sizeof(tmpdir) + 32];
+            sprintf(name, "%s/%d.cache", tmpdir, b->line);
+            s->SetCacheFile(name);
+        }
+        owners[nowners++] = b;
+    }
+
+    int threads = cx->set->Jobs();
+    verbose("*** Running %d jobs of %s on %d threads\n", n, file, threads);
+    /* owners first: a job waiting for its owner never holds up that one */
+    for (int i=0; i<nothers; i++)
+        owners[nowners+i] = others[i];
+    pool(owners, nowners + nothers, threads);
+
+    int status = 0, failed = 0;
+    for (b = jobs; b; b = b->next) {
+        if (b->status) {
+            fprintf(stderr,"*** %s:%d: Job failed with exit code %d\n",
+                file, b->line, b->status);
+            failed++;
+        }
+        if (b->status > status) status = b->status;
+    }
+    verbose("*** Finished batch: %d of %d jobs failed\n", failed, n);
+
+    for (int i=0; i<nowners; i++) {
+        const char* cache = owners[i]->cx->set->CacheFile();
+        if (hasdir && !strncmp(cache, tmpdir, strlen(tmpdir))) remove(cache);
+    }
+    if (hasdir) rmdir(tmpdir);
+    delete[] owners;
+    delete[] others;
+    while (jobs) {
+        b = jobs;
+        jobs = b->next;
+        delete b;
+    }
+    ctx = cx;
+    return status;
+}
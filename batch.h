@@ -0,0 +1,55 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef __BATCH_H__
+#define __BATCH_H__
+
+#include <pthread.h>
+
+class Context;
+
+/* Batch mode (-B manifest): each line of the manifest holds the arguments
+ * of one amdasm run, and the jobs run on a pool of -j threads. The first
+ * job of each DEF file parses it and saves the result like option -C does;
+ * the other jobs of that DEF file wait for this, load it and start with
+ * phase 2a. A line with bad arguments is a failed job. */
+class Batch
+{
+protected:
+    Batch* next;
+    int line;           /* line in manifest */
+    Context* cx;
+    Batch* owner;       /* job that parses the DEF file, 0 if this one */
+    int status;         /* exit code of the job */
+    bool ready;         /* owner: phase 1 is done */
+    pthread_mutex_t lock;
+    pthread_cond_t done;
+
+    Batch(int ln, Context* c);
+    ~Batch();
+    void run();
+    void wait();
+    static Batch* read(const char* file);
+    static void pool(Batch** jobs, int n, int threads);
+    static void* worker(void* arg);
+public:
+    void Ready();
+
+    static int Run(Context* cx);
+};
+
+#endif
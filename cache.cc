@@ -0,0 +1,287 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "amdasm.h"
+
+#define CACHE_MAGIC "AMDASM DEF CACHE 3\n"
+
+Cache::Cache(const char* buf, long len)
+    : pos(buf), end(buf + len), bad(false)
+{}
+
+/* FNV-1a of DEF file and program version */
+unsigned long long Cache::Hash(Input* def)
+{
+    unsigned long long h = 14695981039346656037ULL;
+    const unsigned char* p = (const unsigned char*)def->Buffer();
+    for (long i=0; i<def->Size(); i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    for (const char* v = VERSION; *v; v++) {
+        h ^= (unsigned char)*v;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/* bytes of the bit planes of a field map */
+int Cache::map_size(const Field* fi)
+{
+    return 3 * fi->map->nl * sizeof(Limb);
+}
+
+/****************************************************************************/
+
+void Cache::get_bytes(char* buf, int n)
+{
+    if (bad || n < 0 || n > end - pos) {
+        bad = true;
+        memset(buf, 0, n > 0 ? n : 0);
+        return;
+    }
+    memcpy(buf, pos, n);
+    pos += n;
+}
+
+int Cache::get_int()
+{
+    int v;
+    get_bytes((char*)&v, sizeof(int));
+    return v;
+}
+
+char* Cache::get_str()
+{
+    int n = get_int();
+    if (n < 0 || n > end - pos) {
+        bad = true;
+        n = 0;
+    }
+    char* s = new char[n+1];
+    get_bytes(s, n);
+    s[n] = '\0';
+    return s;
+}
+
+Field* Cache::get_field()
+{
+    Fdecl fd;
+    int isa = get_int();
+    fd.sz = get_int();
+    int offset = get_int();
+    fd.value = get_int();
+    fd.fmt = get_int();
+    /* a field outside a 128 bit word would overrun the bit planes */
+    if (bad || fd.sz <= 0 || fd.sz > 128 || offset < 0 || offset + fd.sz > 128) {
+        bad = true;
+        return 0;
+    }
+
+    Field* fi;
+    switch (isa) {
+    case FISA_DC:       fi = new Field(fd, offset); break;
+    case FISA_CONST:    fi = new CField(fd, offset); break;
+    case FISA_VAR:      fi = new VField(fd, offset); break;
+    default:
+        bad = true;
+        return 0;
+    }
+    /* restore state as built in phase 1 */
+    if (isa != FISA_DC) ((CField*)fi)->value = fd.value;
+    get_bytes((char*)fi->map->val, map_size(fi));
+    return fi;
+}
+
+Symbol* Cache::get_symbol()
+{
+    int isa = get_int();
+    char* name = get_str();
+    Symbol* s = 0;
+    Fdecl val;
+    int nf;
+
+    switch (isa) {
+    case ISA_EQU:
+        val.fmt = get_int();
+        val.sz = get_int();
+        val.value = get_int();
+        s = new Equ(name, val);
+        break;
+    case ISA_SUB:
+    case ISA_DEF:
+        nf = get_int();
+        if (nf < 0 || nf > MAXDEFFIELDS) {
+            bad = true;
+            break;
+        }
+        s = isa == ISA_DEF ? new Def(name) : new Sub(name);
+        for (int i=0; i<nf && !bad; i++) {
+            Field* fi = get_field();
+            if (fi && !((Sub*)s)->AddField(fi)) bad = true;
+        }
+        break;
+    default:
+        bad = true;
+    }
+    delete[] name;
+    if (bad) {
+        delete s;
+        s = 0;
+    }
+    return s;
+}
+
+/* read cache file and replace the result of phase 1 */
+bool Cache::Load(Context* cx)
+{
+    const char* file = cx->set->CacheFile();
+    if (file == 0) return false;
+    Input* def = Input::Open(cx->set->DefFile());
+    Input* in = Input::Open(file);
+    if (def == 0 || in == 0) return false;
+
+    Cache c(in->Buffer(), in->Size());
+    char magic[sizeof(CACHE_MAGIC)];
+    unsigned long long h;
+    c.get_bytes(magic, sizeof(CACHE_MAGIC));
+    c.get_bytes((char*)&h, sizeof(h));
+    if (c.bad || memcmp(magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) || h != Hash(def)) {
+        verbose("*** DEF cache %s does not match, running phase 1\n", file);
+        return false;
+    }
+
+    int wordsize = c.get_int();
+    ColMap* columns = new ColMap();
+    int ncols = c.get_int();
+    if (ncols < 0 || ncols > 127) c.bad = true;
+    for (int i=0; i<ncols && !c.bad; i++)
+        columns->AddColumn(c.get_int());
+
+    Symtab* symtab = new Symtab(cx->idents);
+    int nsyms = c.get_int();
+    for (int i=0; i<nsyms && !c.bad; i++) {
+        Symbol* s = c.get_symbol();
+        if (s) symtab->Enter(s);
+    }
+
+    if (c.bad || wordsize < 1 || wordsize > 128) {
+        verbose("*** DEF cache %s is damaged, running phase 1\n", file);
+        delete columns;
+        delete symtab;
+        return false;
+    }
+    verbose("*** Read DEF cache %s (Phase 1 skipped)\n", file);
+    cx->set->SetWordSize(wordsize);
+    delete cx->columns;
+    cx->columns = columns;
+    delete cx->symtab;
+    cx->symtab = symtab;
+    return true;
+}
+
+/****************************************************************************/
+
+void Cache::put_int(FILE* fd, int v)
+{
+    fwrite(&v, sizeof(int), 1, fd);
+}
+
+void Cache::put_str(FILE* fd, const char* s)
+{
+    int n = strlen(s);
+    put_int(fd, n);
+    fwrite(s, 1, n, fd);
+}
+
+void Cache::put_field(FILE* fd, const Field* fi)
+{
+    int isa = fi->IsA();
+    put_int(fd, isa);
+    put_int(fd, fi->sz);
+    put_int(fd, fi->offset);
+    if (isa == FISA_DC) {
+        put_int(fd, 0);
+        put_int(fd, F_DC);
+        fwrite(fi->map->val, 1, map_size(fi), fd);
+    } else {
+        const CField* cf = (const CField*)fi;
+        put_int(fd, cf->value);
+        put_int(fd, cf->fmt);
+        fwrite(fi->map->val, 1, map_size(fi), fd);
+    }
+}
+
+void Cache::put_symbol(FILE* fd, const Symbol* s)
+{
+    put_int(fd, s->IsA());
+    put_str(fd, s->Name());
+    if (s->IsA() == ISA_EQU) {
+        const Fdecl& val = s->GetValue();
+        put_int(fd, val.fmt);
+        put_int(fd, val.sz);
+        put_int(fd, val.value);
+    } else {
+        const Sub* sub = (const Sub*)s;
+        put_int(fd, sub->nf);
+        for (int i=0; i<sub->nf; i++)
+            put_field(fd, sub->f[i]);
+    }
+}
+
+/* write the result of phase 1 */
+void Cache::Save(Context* cx)
+{
+    const char* file = cx->set->CacheFile();
+    if (file == 0) return;
+    Input* def = Input::Open(cx->set->DefFile());
+    if (def == 0) return;
+
+    char* tmp = new char[strlen(file) + 5];
+    sprintf(tmp, "%s.tmp", file);
+    FILE* fd = fopen(tmp, "wb");
+    if (fd == 0) {
+        verbose("*** Cannot write DEF cache %s\n", file);
+        delete[] tmp;
+        return;
+    }
+
+    unsigned long long h = Hash(def);
+    fwrite(CACHE_MAGIC, 1, sizeof(CACHE_MAGIC), fd);
+    fwrite(&h, sizeof(h), 1, fd);
+    put_int(fd, cx->set->WordSize());
+
+    ColMap* cols = cx->columns;
+    put_int(fd, cols->ncols);
+    for (int i=0; i<cols->ncols; i++)
+        put_int(fd, cols->col[i]);
+
+    Symtab* tab = cx->symtab;
+    put_int(fd, tab->Count());
+    for (Symbol* s = tab->First(); s; s = s->Next())
+        put_symbol(fd, s);
+
+    bool ok = !ferror(fd);
+    if (fclose(fd) != 0) ok = false;
+    if (ok && rename(tmp, file) == 0)
+        verbose("*** Write DEF cache %s\n", file);
+    else {
+        verbose("*** Cannot write DEF cache %s\n", file);
+        remove(tmp);
+    }
+    delete[] tmp;
+}
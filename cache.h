@@ -0,0 +1,51 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef __CACHE_H__
+#define __CACHE_H__
+
+/* The result of phase 1 (DEF symbols, WORD size and COLS), saved to a
+ * file, so that later runs with an unchanged DEF file can skip phase 1.
+ * The cache is keyed by a hash of the DEF file and the program version;
+ * if it does not match or is damaged, phase 1 runs and rewrites it. */
+class Cache
+{
+protected:
+    const char* pos;    /* read position in mapped cache file */
+    const char* end;
+    bool bad;
+
+    Cache(const char* buf, long len);
+
+    int get_int();
+    char* get_str();
+    void get_bytes(char* buf, int n);
+    Symbol* get_symbol();
+    Field* get_field();
+
+    static void put_int(FILE* fd, int v);
+    static void put_str(FILE* fd, const char* s);
+    static void put_symbol(FILE* fd, const Symbol* s);
+    static void put_field(FILE* fd, const Field* fi);
+    static int map_size(const Field* fi);
+public:
+    static unsigned long long Hash(Input* def);
+    static bool Load(Context* cx);
+    static void Save(Context* cx);
+};
+
+#endif
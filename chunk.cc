@@ -0,0 +1,154 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "amdasm.h"
+#include <pthread.h>
+
+/* chunks per job, to even out different statement costs */
+#define CHUNKS_PER_JOB 4
+
+/* state shared by the worker threads */
+struct Pool
+{
+    pthread_mutex_t lock;
+    Chunk* next;        /* next chunk to assemble */
+    Context* parent;
+};
+
+Chunk::Chunk(Context* cx, const char* st)
+    : next(0), start(st), work(0)
+{
+    first = cx->tape->Size();
+    locptr = cx->set->LocPtr();
+    lineno = cx->p->Lineno();
+    if (cx->lastchunk)
+        cx->lastchunk->next = this;
+    else
+        cx->chunks = this;
+    cx->lastchunk = this;
+}
+
+Chunk::~Chunk()
+{
+    delete work;
+}
+
+/* the debug output of the parser and scanner is serial only,
+ * and so is streaming the output files */
+bool Chunk::Parallel(Context* cx)
+{
+    Settings* s = cx->set;
+    return s->Jobs() > 1 && !s->SinglePass() && !Output::Streaming(cx) &&
+           !s->IsDebug(DBG_YACC|DBG_LEX|DBG_DEFS|DBG_SUBST);
+}
+
+/* phase 2a: begin the list of chunks */
+void Chunk::Start(Context* cx, Input* in)
+{
+    cx->chunksize = in->Size() / (cx->set->Jobs() * CHUNKS_PER_JOB);
+    if (cx->chunksize < 1) cx->chunksize = 1;
+    new Chunk(cx, in->Buffer());
+}
+
+/* phase 2a: at a statement boundary, possibly start a new chunk */
+void Chunk::Mark(Context* cx)
+{
+    if (cx->chunksize == 0) return;
+    if (cx->lineptr - cx->lastchunk->start >= cx->chunksize)
+        new Chunk(cx, cx->lineptr);
+}
+
+/* assemble the statements of this chunk in a worker context */
+void Chunk::assemble(Context* parent)
+{
+    work = new Context(parent);
+    ctx = work;
+    work->set->ResetLocPtr();
+    work->set->IncLocPtr(locptr);
+    work->p = new Printer(parent->p);
+    work->p->SetLineno(lineno);
+
+    scan_tape(work, first, next ? next->first : work->tape->Size(), next == 0);
+    if (yyparse(work)) work->failed = true;
+    scan_end(work);
+    ctx = 0;
+}
+
+void* Chunk::worker(void* arg)
+{
+    Pool* pool = (Pool*)arg;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        Chunk* c = pool->next;
+        if (c) pool->next = c->next;
+        pthread_mutex_unlock(&pool->lock);
+        if (c == 0) break;
+        c->assemble(pool->parent);
+    }
+    return 0;
+}
+
+/* append the result of a worker */
+void Chunk::merge(Context* cx)
+{
+    work->p->Replay(cx->p);
+    if (work->lroot) {
+        Lineout* tail = work->lroot;
+        while (tail->next) tail = tail->next;
+        tail->next = cx->lroot;
+        cx->lroot = work->lroot;
+        work->lroot = 0;
+        cx->arena->Take(work->arena);
+    }
+    cx->set->ResetLocPtr();
+    cx->set->IncLocPtr(work->set->LocPtr());
+}
+
+/* phase 2b: assemble the chunks on a pool of threads */
+void Chunk::Assemble(Context* cx)
+{
+    Chunk* c;
+    int n = 0;
+    for (c = cx->chunks; c; c = c->next) n++;
+
+    int jobs = cx->set->Jobs();
+    if (jobs > n) jobs = n;
+    pthread_t* tids = new pthread_t[jobs];
+
+    Pool pool;
+    pthread_mutex_init(&pool.lock, 0);
+    pool.next = cx->chunks;
+    pool.parent = cx;
+    for (int i=0; i<jobs; i++)
+        if (pthread_create(&tids[i], 0, worker, &pool))
+            internal_error(__FILE__, __LINE__);
+    for (int i=0; i<jobs; i++)
+        pthread_join(tids[i], 0);
+    pthread_mutex_destroy(&pool.lock);
+    delete[] tids;
+
+    for (c = cx->chunks; c; c = c->next) {
+        if (c->work->failed) break;
+        c->merge(cx);
+    }
+    if (c == 0) return;
+
+    /* redo the rest serially, for the diagnostics */
+    scan_tape(cx, c->first, cx->tape->Size(), true);
+    yyparse(cx);
+    scan_end(cx);
+}
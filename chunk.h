@@ -0,0 +1,54 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef __CHUNK_H__
+#define __CHUNK_H__
+
+class Context;
+
+/* A range of SRC statements, assembled in phase 2b by a worker thread.
+ * Phase 2a marks the ranges at statement boundaries of its token tape,
+ * together with the location pointer and listing line number there, so
+ * that each worker can start in the middle of the file. The results are merged in order;
+ * if a worker runs into any error, its chunk and all following ones are
+ * assembled serially again, so diagnostics are the same as without -j. */
+class Chunk
+{
+protected:
+    Chunk* next;
+    const char* start;  /* first statement of chunk in SRC */
+    int first;          /* first tape entry */
+    int locptr;         /* location pointer at start */
+    int lineno;         /* listing line number at start */
+    Context* work;      /* worker that assembled this chunk */
+
+    Chunk(Context* cx, const char* st);
+    void assemble(Context* parent);
+    void merge(Context* cx);
+    static void* worker(void* arg);
+public:
+    ~Chunk();
+
+    Chunk* Next() const { return next; }
+
+    static bool Parallel(Context* cx);
+    static void Start(Context* cx, Input* in);
+    static void Mark(Context* cx);
+    static void Assemble(Context* cx);
+};
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "amdasm.h"
+
+thread_local Context* ctx = 0;
+
+Context::Context()
+    : values(0), p(0), lroot(0), words(0), lrevflag(false), oroot(0), streaming(false), nstream(0), iroot(0), froot(0), tape(0),
+      defdone(false), spool(0), nspool(0), lib(0), bailout(0), job(0),
+      parent(0), failed(false), chunks(0), lastchunk(0), chunksize(0),
+      lineptr(0), vdef(0), outline(0), ffcnt(0), vsize(0), fwdname(0), fwdline(0), fwdtext(0),
+      scanner(0), scanbuf(0), replay(false), tapepos(0), tapeend(0),
+      iskwd(false), start_token(0)
+{
+    set = new Settings();
+    arena = new Arena();
+    idents = new Idents();
+    symtab = new Symtab(idents);
+    labels = new Symtab(idents);
+    columns = new ColMap();
+    vdecl.Set(0, 0, 0);
+}
+
+/* a phase 2b worker: reads the finished tables of its parent,
+ * but has its own location pointer, listing and generated lines */
+Context::Context(Context* par)
+    : values(0), p(0), lroot(0), words(0), lrevflag(false), oroot(0), streaming(false), nstream(0), iroot(0), froot(0), tape(0),
+      defdone(false), spool(0), nspool(0), lib(0), bailout(0), job(0),
+      parent(par), failed(false), chunks(0), lastchunk(0), chunksize(0),
+      lineptr(0), vdef(0), outline(0), ffcnt(0), vsize(0), fwdname(0), fwdline(0), fwdtext(0),
+      scanner(0), scanbuf(0), replay(false), tapepos(0), tapeend(0),
+      iskwd(false), start_token(0)
+{
+    set = new Settings(*par->set);
+    arena = new Arena();
+    tape = par->tape;
+    idents = par->idents;
+    symtab = par->symtab;
+    labels = par->labels;
+    values = par->values;
+    columns = par->columns;
+    vdecl.Set(0, 0, 0);
+}
+
+Context::~Context()
+{
+    scan_free(this);
+    while (oroot) {
+        Output* o = oroot;
+        oroot = o->Next();
+        delete o;
+    }
+    while (froot) {
+        Fixup* fx = froot;
+        froot = fx->Next();
+        delete fx;
+    }
+    while (iroot) {
+        Input* in = iroot;
+        iroot = in->Next();
+        delete in;
+    }
+    while (chunks) {
+        Chunk* c = chunks;
+        chunks = c->Next();
+        delete c;
+    }
+    delete p;
+    delete[] fwdtext;
+    if (!parent) {
+        delete values;
+        delete tape;
+        delete columns;
+        delete labels;
+        delete symtab;
+        delete idents;
+    }
+    delete words;
+    delete arena;           /* all lines at once */
+    delete set;
+}
+
+/* run all phases in the context of the calling thread */
+int Context::Run()
+{
+    Context* cur = ctx;
+    ctx = this;
+
+    int errors = 0;
+    for (int phase = 1; phase <=3; phase++) {
+        /* other jobs of the DEF file may start */
+        if (phase == 2 && job)
+            job->Ready();
+        /* DEFs are complete, however phase 1 was done; a resident
+         * DEF of the server is prepared already */
+        if (phase == 2 && !defdone)
+            for (Symbol* s = symtab->First(); s; s = s->Next())
+                if (s->IsDef()) ((Def*)s)->Prepare();
+        /* single pass mode collects labels in phase 2b */
+        if (phase == 2 && set->SinglePass()) continue;
+        /* unchanged DEF file: take symbols from the cache */
+        if (phase == 1 && (defdone || Cache::Load(this))) continue;
+        errors = parse_file(phase);
+        if (errors != 0) break;
+        if (phase == 1) Cache::Save(this);
+        if (phase == 2) values = new Valtab(labels, symtab, idents->Ids());
+    }
+
+    ctx = cur;
+    return errors;
+}
@@ -0,0 +1,88 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef __CONTEXT_H__
+#define __CONTEXT_H__
+
+/* All state of one assembler run. The parser and scanner get it passed
+ * explicitly; other code uses the context of the current thread, so
+ * several assemblies may run on different threads of one process. */
+class Context
+{
+public:
+    Settings* set;
+    Arena* arena;           /* generated lines, see Lineout */
+    Idents* idents;          /* identifiers of DEF and SRC */
+    Symtab* symtab;
+    Symtab* labels;
+    Valtab* values;         /* frozen labels and EQUs for phase 2b */
+    ColMap* columns;
+    Printer* p;
+
+    Lineout* lroot;         /* generated lines, see Lineout::First */
+    Words* words;           /* the lines packed after phase 2b */
+    bool lrevflag;
+    Output* oroot;          /* requested output files */
+    bool streaming;         /* -w in effect, see Output::Stream */
+    int nstream;            /* lines since the last window */
+    Input* iroot;           /* mapped input files */
+    Fixup* froot;           /* pending forward references */
+    Tape* tape;             /* tokens of phase 2a */
+    bool defdone;           /* phase 1 result is given, see Server */
+    const char* spool;      /* server request: directory for output files */
+    int nspool;
+    Library* lib;           /* called through libamdasm, see Library */
+    jmp_buf* bailout;       /* library: where fatal errors return to */
+    Batch* job;             /* batch: waits for phase 1, see Batch::Ready */
+
+    /* parallel phase 2b, see Chunk */
+    Context* parent;        /* worker: shares the tables of parent */
+    bool failed;            /* worker gave up, chunk is redone serially */
+    Chunk* chunks;
+    Chunk* lastchunk;
+    long chunksize;         /* bytes per chunk, 0 if serial */
+    const char* lineptr;    /* start of line after last NL */
+
+    /* parser state */
+    Fdecl vdecl;
+    Sub* vdef;
+    Lineout* outline;
+    int ffcnt, vsize;
+    const Ident* fwdname;
+    int fwdline;            /* where fwdname is, see Fixup */
+    char* fwdtext;
+
+    /* scanner state */
+    void* scanner;
+    void* scanbuf;
+    bool replay;            /* read tokens from tape */
+    int tapepos, tapeend;
+    bool iskwd;
+    int start_token;
+
+    Context();
+    Context(Context* parent);
+    ~Context();
+
+    bool Worker() const { return parent != 0; }
+
+    int Run();
+};
+
+extern thread_local Context* ctx;
+
+#endif
@@ -25,7 +25,7 @@ Symbol::Symbol(const char* nam)
 
 Symbol::~Symbol()
 {
-    delete name;
+    delete[] name;
 }
 
 Field* Symbol::GetField(int dummy) const
@@ -59,14 +59,18 @@ void Symbol::Print(Printer* pr, bool dummy) const
 /****************************************************************************/
 
 Sub::Sub(const char* name, int max)
-    : Symbol(name), nf(0), maxf(max), sz(0)
+    : Symbol(name), nf(0), maxf(max), nv(0), sz(0)
 {
     f = new Field*[maxf];
+    v = new const VField*[maxf];
 }
 
 Sub::~Sub()
 {
+    for (int i=0; i<nf; i++)
+        delete f[i];
     delete[] f;
+    delete[] v;
 }
 
 bool Sub::AddField(Field* fi)
@@ -84,13 +88,21 @@ bool Sub::AddField(Field* fi)
     sz += fisz;
 
     f[nf++] = fi;
+    if (fi->IsVField()) v[nv++] = (const VField*)fi;
 	return true;
 }
 
+const VField* Sub::GetVfs(int num) const
+{
+    if (num < nv) return v[num];
+    yyerror("Too many VFS arguments");
+    return 0;
+}
+
 /* lookup an EQU or SUB, and include it in this def/sub */
-bool Sub::Include(const char* name)
+bool Sub::Include(const Ident* name)
 {
-    Symbol* s = symtab->Lookup(name);
+    Symbol* s = ctx->symtab->Lookup(name);
     if (!s) {
         yyerror("Name not defined");
         return false;
@@ -146,29 +158,49 @@ void Sub::Debug(const char* pfx)
 
 /****************************************************************************/
 
-bool Def::Init(char* line)
+Def::~Def()
 {
+    delete base;
+    delete vfs;
+}
+
+/* the word as Init leaves it on an empty line: constants placed,
+ * VFS defaults and X initialization applied */
+void Def::Prepare()
+{
+    if (base || sz != ctx->set->WordSize()) return;
+    base = new Bitplanes(sz, OVL('X'));
+    vfs = new Bitplanes(sz, 'X');
     for (int i=0; i<nf; i++) {
         const Field* fd = get(i);
-        if (!fd->Init(line)) {
-            fprintf(stderr," Init failed %s i=%d!\n", name, i); exit(1);
-            return false;
-        }
+        base->Overlay(fd->Offset(), fd->Map());
+        if (fd->IsVField())
+            vfs->SetOvl(fd->Offset(), fd->Size());
     }
-    return true;
 }
 
-const VField* Def::GetVfs(int num) const
+bool Def::Init(Bitplanes* line)
 {
+    /* one merge, unless a field conflicts or each one is traced */
+    if (base && !ctx->set->IsDebug(DBG_SUBST) && line->Merge(base, vfs))
+        return true;
+
     for (int i=0; i<nf; i++) {
-        const Field* vfs = get(i);
-        if (vfs->IsVField()) {
-            if (num == 0) return (VField*)vfs;
-            num--;
+        const Field* fd = get(i);
+        if (!fd->Init(line)) {
+            if (ctx->Worker()) {    /* chunk is redone serially */
+                ctx->failed = true;
+                return false;
+            }
+            if (ctx->lib)
+                ctx->lib->Error(ctx->set->CurFile(), ctx->p->Lineno(), 0, "Init failed");
+            else
+                fprintf(stderr," Init failed %s i=%d!\n", name, i);
+            fatal(1);
+            return false;
         }
     }
-    yyerror("Too many VFS arguments");
-    return 0;
+    return true;
 }
 
 /****************************************************************************/
@@ -188,47 +220,52 @@ void Equ::Debug()
 
 /****************************************************************************/
 
-Symtab::Symtab()
+Symtab::Symtab(Idents* nm)
+    : idents(nm), sym(0), size(0), count(0), first(0), last(0)
 {
-    for (int i=0; i<TBLSIZE; i++)
-        tbl[i] = 0;
 }
 
-int Symtab::hash(const char* name)
+Symtab::~Symtab()
 {
-    int h = 0;
-    const char* n = name;
-    while (*n) {
-        h += *n++;
+    while (first) {
+        Symbol* s = first;
+        first = s->next;
+        delete s;
     }
-    return h % TBLSIZE;
-}
-
-Symbol* Symtab::Lookup(const char* name)
-{
-    int h = hash(name);
-    Symbol* s = tbl[h];
-    while (s && strcasecmp(s->Name(), name)) s = s->Next();
-    return s;
+    delete[] sym;
 }
 
-bool Symtab::Enter(Symbol* sym)
+bool Symtab::Enter(Symbol* s)
 {
-    const char* name = sym->Name();
-    if (Lookup(name)) {
+    const char* name = s->Name();
+    int id = idents->Intern(name, strlen(name))->id;
+    if (Lookup(id)) {
         yyerror("Duplicate declaration");
         return false;
     }
-    int h = hash(name);
-    sym->next = tbl[h];
-    tbl[h] = sym;
+    if (id >= size) {
+        int nsize = idents->Ids() > 2*size ? idents->Ids() : 2*size;
+        Symbol** nsym = new Symbol*[nsize];
+        if (size) memcpy(nsym, sym, size * sizeof(Symbol*));
+        memset(nsym + size, 0, (nsize-size) * sizeof(Symbol*));
+        delete[] sym;
+        sym = nsym;
+        size = nsize;
+    }
+    sym[id] = s;
+    count++;
+
+    s->next = 0;
+    if (last) last->next = s;
+    else first = s;
+    last = s;
     return true;
 }
 
 /* lookup a value of an EQU */
-bool Symtab::LookupValue(const char* name, Fdecl* res, bool quiet)
+bool Symtab::LookupValue(const Ident* nm, Fdecl* res, bool quiet)
 {
-    Symbol* s = Lookup(name);
+    Symbol* s = Lookup(nm);
     if (s == 0) {
         if (!quiet) yyerror("Undeclared NAME");
         return false;
@@ -245,14 +282,10 @@ bool Symtab::LookupValue(const char* name, Fdecl* res, bool quiet)
 bool Symtab::PrintSymbols(Printer* pr, bool dump_entry, bool hex) const
 {
     bool found = false;
-    for (int i=0; i<TBLSIZE; i++) {
-        Symbol* s = tbl[i];
-        while (s) {
-            if (s->IsEntry()==dump_entry) {
-                s->Print(pr, hex);
-                found = true;
-            }
-            s = s->Next();
+    for (Symbol* s = first; s; s = s->Next()) {
+        if (s->IsEntry()==dump_entry) {
+            s->Print(pr, hex);
+            found = true;
         }
     }
     return found;
@@ -260,15 +293,27 @@ bool Symtab::PrintSymbols(Printer* pr, bool dump_entry, bool hex) const
 
 /****************************************************************************/
 
+Valtab::Valtab(const Symtab* labels, const Symtab* symtab, int ids)
+    : size(ids)
+{
+    sym = new Symbol*[size];
+    for (int i=0; i<size; i++) {
+        sym[i] = labels->Lookup(i);
+        if (!sym[i]) sym[i] = symtab->Lookup(i);
+    }
+}
+
+Valtab::~Valtab()
+{
+    delete[] sym;
+}
+
+/****************************************************************************/
+
 Label::Label(const char* name, int loc, bool entry)
     : Symbol(name), locptr(loc), isentry(entry)
-{}
-
-const Fdecl& Label::GetValue() const
 {
-    static Fdecl ret;
-    ret.Set(F_DEC|FM_PAGE, CField::DecBitsize(locptr), locptr);
-    return ret;
+    value.Set(F_DEC|FM_PAGE, CField::DecBitsize(locptr), locptr);
 }
 
 void Label::Print(Printer* pr, bool hex) const
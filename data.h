@@ -53,8 +53,11 @@ class Sub : public Symbol
 protected:
     Field ** f;
     int nf, maxf;
+    const VField** v;   /* the VFS fields of f, in order */
+    int nv;
     int sz;
     const Field* get(int i) const;
+    friend class Cache;
     
 public:
     Sub(const char* name, int max=MAXSUBFIELDS);
@@ -62,9 +65,10 @@ public:
     int IsA() const { return ISA_SUB; }
     
     bool AddField(Field* fi);
-    bool Include(const char* name);
+    bool Include(const Ident* name);
     int FieldCnt() const { return nf; }
     Field* GetField(int i) const { return get(i)->Clone(); }
+    const VField* GetVfs(int num) const;
     int Bitsize() const { return sz; }
     void Debug(const char* pfx);
 };
@@ -73,14 +77,17 @@ public:
 #define ISA_DEF   3
 class Def : public Sub
 {
+protected:
+    Bitplanes* base;    /* all fields overlaid, see Prepare */
+    Bitplanes* vfs;     /* overlayable bits of VFS fields */
 public:
     Def(const char* name)
-    : Sub(name, MAXDEFFIELDS) {}
-    ~Def() {}
+    : Sub(name, MAXDEFFIELDS), base(0), vfs(0) {}
+    ~Def();
     int IsA() const { return ISA_DEF; }
     bool IsDef() const { return true; }
-    bool Init(char* line);
-    const VField* GetVfs(int num) const;
+    void Prepare();
+    bool Init(Bitplanes* line);
 };
 
 #define ISA_EQU   4
@@ -98,24 +105,45 @@ public:
     void Debug();
 };
 
-#define TBLSIZE   97
-class Symtab { /* Singleton pattern */
+/* symbols indexed by the id of their name, see Idents; symbols
+ * are also linked in order of declaration, which is the listing order */
+class Symtab {
 protected:
-    Symbol* tbl[TBLSIZE];
-    int hash(const char* name); 
+    Idents* idents;
+    Symbol** sym;       /* by name id */
+    int size;
+    int count;
+    Symbol* first;
+    Symbol* last;
 public:
-    Symtab();
+    Symtab(Idents* nm);
     ~Symtab();
     
-    Symbol* Lookup(const char* name);
-    bool LookupValue(const char* name, Fdecl* res, bool quiet=false);
+    Symbol* First() const { return first; }
+    int Count() const { return count; }
+    
+    Symbol* Lookup(int id) const { return id >= 0 && id < size ? sym[id] : 0; }
+    Symbol* Lookup(const Ident* nm) const { return Lookup(nm->id); }
+    Symbol* Lookup(const char* name) const { return Lookup(idents->Id(name)); }
+    bool LookupValue(const Ident* nm, Fdecl* res, bool quiet=false);
     bool Enter(Symbol* sym);
     
     bool PrintSymbols(Printer* pr, bool dump_entry, bool hex) const;
 };
 
-extern Symtab* symtab;
-extern Symtab* labels;
+/* Labels and EQUs as phase 2b resolves a NAME: a label hides an EQU.
+ * Neither table changes after phase 2a, so they are frozen into one
+ * flat array by name id, which the workers read without locks. */
+class Valtab {
+protected:
+    Symbol** sym;
+    int size;
+public:
+    Valtab(const Symtab* labels, const Symtab* symtab, int ids);
+    ~Valtab();
+
+    Symbol* Lookup(const Ident* nm) const { return nm->id < size ? sym[nm->id] : 0; }
+};
 
 #define ISA_LABEL 5
 class Label : public Symbol
@@ -123,12 +151,13 @@ class Label : public Symbol
 protected:
     int locptr;
     bool isentry;
+    Fdecl value;
 public:
     Label(const char* name, int loc, bool entry=false);
     ~Label() {}
     int IsA() const { return ISA_LABEL; }
     
-    const Fdecl& GetValue() const;
+    const Fdecl& GetValue() const { return value; }
     bool IsEntry() const { return isentry; }
     void Print(Printer* pr, bool hex) const;
     void Dump(FILE* fd) const;
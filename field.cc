@@ -17,6 +17,10 @@
 */
 #include "amdasm.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 void Fdecl::FixSize()
 {
     if (sz == 0) {
@@ -25,83 +29,304 @@ void Fdecl::FixSize()
     }
 }
 
-Field::Field(int siz)
-    : sz(siz), map(0), offset(0)
-{}
+/****************************************************************************/
+
+/* all bits c, in the char form of OVL('X') etc. */
+Bitplanes::Bitplanes(int size, int c)
+{
+    alloc(size);
+    fill(c);
+}
+
+/* planes in the arena a, which owns them */
+Bitplanes::Bitplanes(int size, int c, Arena* a)
+{
+    alloc(size, a);
+    fill(c);
+}
+
+/* a view of the 3*LIMBS(size) limbs at planes, e.g. a word of Words */
+Bitplanes::Bitplanes(int size, Limb* planes)
+{
+    sz = size;
+    nl = LIMBS(size);
+    val = planes;
+    def = val + nl;
+    ovl = def + nl;
+    mem = 0;
+}
+
+void Bitplanes::fill(int c)
+{
+    int u = UN_OVL(c);
+    memset(val, (u == '1' || u == 0) ? 0xff : 0, nl * sizeof(Limb));
+    memset(def, (u == '1' || u == '0') ? 0xff : 0, nl * sizeof(Limb));
+    memset(ovl, IS_OVL(c) ? 0xff : 0, nl * sizeof(Limb));
+}
+
+Bitplanes::Bitplanes(const Bitplanes& org)
+{
+    alloc(org.sz);
+    memcpy(val, org.val, 3 * nl * sizeof(Limb));
+}
 
-char* Field::mkbuf(int size, int defval)
+Bitplanes::~Bitplanes()
 {
-    char* buf = new char[size+1];
-    buf[size] = '\0';
-    memset(buf, defval, size);
-    return buf;
+    delete[] mem;
 }
 
+void Bitplanes::alloc(int size, Arena* a)
+{
+    sz = size;
+    nl = LIMBS(size);
+    mem = a ? 0 : new Limb[3*nl];
+    val = a ? (Limb*)a->Alloc(3*nl*sizeof(Limb)) : mem;
+    def = val + nl;
+    ovl = def + nl;
+}
+
+/* n bits starting at pos, n <= 64 */
+Limb Bitplanes::get(const Limb* p, int pos, int n)
+{
+    int i = pos / LIMB_BITS, sh = pos % LIMB_BITS;
+    Limb v;
+    if (sh + n <= LIMB_BITS)
+        v = p[i] >> (LIMB_BITS - sh - n);
+    else {
+        int r = sh + n - LIMB_BITS;
+        v = (p[i] << r) | (p[i+1] >> (LIMB_BITS - r));
+    }
+    return v & LIMB_MASK(n);
+}
+
+void Bitplanes::put(Limb* p, int pos, int n, Limb v)
+{
+    int i = pos / LIMB_BITS, sh = pos % LIMB_BITS;
+    Limb m = LIMB_MASK(n);
+    v &= m;
+    if (sh + n <= LIMB_BITS) {
+        int s = LIMB_BITS - sh - n;
+        p[i] = (p[i] & ~(m << s)) | (v << s);
+    } else {
+        int r = sh + n - LIMB_BITS;
+        p[i] = (p[i] & ~(m >> r)) | (v >> r);
+        p[i+1] = (p[i+1] & ~(m << (LIMB_BITS - r))) | (v << (LIMB_BITS - r));
+    }
+}
+
+/* char form of a bit, without OVL marker */
+int Bitplanes::Bit(int i) const
+{
+    int sh = LIMB_BITS-1 - i % LIMB_BITS;
+    int v = (val[i / LIMB_BITS] >> sh) & 1;
+    int d = (def[i / LIMB_BITS] >> sh) & 1;
+    return d ? (v ? '1' : '0') : (v ? 0 : 'X');
+}
+
+/* char form of 4 bits as by Bit, indexed by val<<4 | def */
+static struct NibbleText
+{
+    char t[256][4];
+    NibbleText() {
+        for (int i=0; i < 256; i++)
+            for (int k=0; k < 4; k++) {
+                int v = (i >> (7-k)) & 1, d = (i >> (3-k)) & 1;
+                t[i][k] = d ? (v ? '1' : '0') : (v ? 0 : 'X');
+            }
+    }
+} nibbles;
+
+/* char form of n bits at pos, a nibble at a time. Returns the end;
+ * up to 3 bytes after it are clobbered */
+char* Bitplanes::Text(char* p, int pos, int n) const
+{
+    while (n > 0) {
+        int k = n < 16 ? n : 16;
+        unsigned v = get(val, pos, k) << (16-k);
+        unsigned d = get(def, pos, k) << (16-k);
+        pos += k;
+        n -= k;
+        for (int sh = 12; k > 0; sh -= 4, k -= 4) {
+            memcpy(p, nibbles.t[((v >> sh) & 15) << 4 | ((d >> sh) & 15)], 4);
+            p += k < 4 ? k : 4;
+        }
+    }
+    return p;
+}
+
+/* Overlay n <= 64 bits at pos. Bits which are not X replace overlayable
+ * bits, and must be the same as bits which are not. Like a bit by bit
+ * copy, the bits left of a conflict are still written. */
+bool Bitplanes::Overlay(int pos, int n, Limb v, Limb d, Limb o)
+{
+    Limb m = LIMB_MASK(n);
+    v &= m; d &= m; o &= m;
+    Limb tv = get(val, pos, n);
+    Limb td = get(def, pos, n);
+    Limb to = get(ovl, pos, n);
+
+    Limb w = v | d;
+    Limb bad = w & ~to & ((tv ^ v) | (td ^ d));
+    if (bad) {
+        /* smear the leftmost conflict to the right */
+        bad |= bad >> 1;  bad |= bad >> 2;  bad |= bad >> 4;
+        bad |= bad >> 8;  bad |= bad >> 16; bad |= bad >> 32;
+        w &= ~bad;
+    }
+    put(val, pos, n, (tv & ~w) | (v & w));
+    put(def, pos, n, (td & ~w) | (d & w));
+    put(ovl, pos, n, (to & ~w) | (o & w));
+    return bad == 0;
+}
+
+bool Bitplanes::Overlay(int pos, const Bitplanes* src)
+{
+    for (int i=0; i < src->sz; i += LIMB_BITS) {
+        int n = src->sz - i < LIMB_BITS ? src->sz - i : LIMB_BITS;
+        if (!Overlay(pos + i, n, get(src->val, i, n),
+                get(src->def, i, n), get(src->ovl, i, n))) return false;
+    }
+    return true;
+}
+
+/* Overlay an image of the same alignment, which is X outside of its
+ * field: limb by limb, with SSE2 two limbs at once. A conflict is left
+ * to the scalar code, so that it writes the same bits as Overlay above */
+bool Bitplanes::Overlay(const Bitplanes* src)
+{
+    int i = 0;
+#ifdef __SSE2__
+    for (; i+2 <= src->nl; i += 2) {
+        __m128i sv = _mm_loadu_si128((const __m128i*)(src->val + i));
+        __m128i sd = _mm_loadu_si128((const __m128i*)(src->def + i));
+        __m128i so = _mm_loadu_si128((const __m128i*)(src->ovl + i));
+        __m128i tv = _mm_loadu_si128((const __m128i*)(val + i));
+        __m128i td = _mm_loadu_si128((const __m128i*)(def + i));
+        __m128i to = _mm_loadu_si128((const __m128i*)(ovl + i));
+
+        __m128i w = _mm_or_si128(sv, sd);
+        __m128i diff = _mm_or_si128(_mm_xor_si128(tv, sv), _mm_xor_si128(td, sd));
+        __m128i bad = _mm_andnot_si128(to, _mm_and_si128(w, diff));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(bad, _mm_setzero_si128())) != 0xffff)
+            break;
+
+        _mm_storeu_si128((__m128i*)(val + i), _mm_or_si128(_mm_andnot_si128(w, tv), _mm_and_si128(w, sv)));
+        _mm_storeu_si128((__m128i*)(def + i), _mm_or_si128(_mm_andnot_si128(w, td), _mm_and_si128(w, sd)));
+        _mm_storeu_si128((__m128i*)(ovl + i), _mm_or_si128(_mm_andnot_si128(w, to), _mm_and_si128(w, so)));
+    }
+#endif
+    return overlay_limbs(src, i);
+}
+
+bool Bitplanes::overlay_limbs(const Bitplanes* src, int i)
+{
+    for (; i < src->nl; i++) {
+        Limb v = src->val[i], d = src->def[i];
+        Limb w = v | d;
+        Limb bad = w & ~ovl[i] & ((val[i] ^ v) | (def[i] ^ d));
+        if (bad) {
+            bad |= bad >> 1;  bad |= bad >> 2;  bad |= bad >> 4;
+            bad |= bad >> 8;  bad |= bad >> 16; bad |= bad >> 32;
+            w &= ~bad;
+        }
+        val[i] = (val[i] & ~w) | (v & w);
+        def[i] = (def[i] & ~w) | (d & w);
+        ovl[i] = (ovl[i] & ~w) | (src->ovl[i] & w);
+        if (bad) return false;
+    }
+    return true;
+}
+
+/* Overlay src as a whole and make the bits of force overlayable;
+ * if any bit conflicts, nothing is written */
+bool Bitplanes::Merge(const Bitplanes* src, const Bitplanes* force)
+{
+    Limb bad = 0;
+    for (int i=0; i < src->nl; i++)
+        bad |= (src->val[i] | src->def[i]) & ~ovl[i] &
+               ((val[i] ^ src->val[i]) | (def[i] ^ src->def[i]));
+    if (bad) return false;
+
+    Overlay(src);
+    for (int i=0; i < src->nl; i++)
+        ovl[i] |= force->ovl[i];
+    return true;
+}
+
+void Bitplanes::SetOvl(int pos, int n)
+{
+    for (int i=0; i < n; i += LIMB_BITS) {
+        int k = n - i < LIMB_BITS ? n - i : LIMB_BITS;
+        put(ovl, pos + i, k, ~0ULL);
+    }
+}
+
+/****************************************************************************/
+
+Field::Field(int siz)
+    : sz(siz), map(0), offset(0), image(0)
+{}
+
 Field::Field(const Fdecl& fd, int off)
-    : sz(fd.sz), offset(off)
+    : sz(fd.sz), offset(off), image(0)
 {
     if (sz == 0) internal_error(__FILE__, __LINE__);
 
-    map = mkbuf(sz, OVL('X'));
+    map = new Bitplanes(sz, OVL('X'));
 }
 
 Field::Field(const Field& org)
-    : sz(org.sz), offset(org.offset)
+    : sz(org.sz), offset(org.offset), image(0)
 {
     if (sz == 0) internal_error(__FILE__, __LINE__);
 
-    map = new char[sz+1];
-    memcpy(map, org.map, sz+1);
+    map = new Bitplanes(*org.map);
 }
 
 Field::~Field()
 {
     delete map;
+    delete image;
     sz = 0;
 }
 
-bool Field::copy_bit(char* tgt, const char* src) const
+/* a field of a SUB or DEF: keep the map at its place in the word,
+ * so that Def::Init can overlay it as a whole */
+void Field::SetOffset(int off)
 {
-    int tt = *tgt;
-    int s = UN_OVL(*src);
-    if (IS_OVL(tt)) {
-        /* allow overlay, if target is overlayable */
-        if (s != 'X') *tgt = *src;
-    } else {
-        /* otherwise only allow it, if source is the same or X */
-        int t = UN_OVL(tt);
-        if (t == s || s == 'X') {
-            if (s != 'X') *tgt = *src;
-        } else {
-            yyerror("Field is already set");
-            return false; /* try to set value into already set field */
-        }
-    }
-    return true;
+    offset = off;
+    delete image;
+    image = new Bitplanes(offset + sz, OVL('X'));
+    image->Overlay(offset, map);
 }
 
-bool Field::Init(char* buf) const
+bool Field::overlay(Bitplanes* tgt) const
 {
     DebugSubst(map);
-
-    for (int i=0; i<sz; i++) {
-        if (!copy_bit(&buf[offset+i], &map[i])) return false;
+    if (!(image ? tgt->Overlay(image) : tgt->Overlay(offset, map))) {
+        yyerror("Field is already set");
+        return false; /* try to set value into already set field */
     }
     return true;
 }
 
+bool Field::Init(Bitplanes* buf) const
+{
+    return overlay(buf);
+}
+
 void Field::Debug(bool dummy) const
 {
     fprintf(stderr,"%dX", sz);
 }
 
-void Field::DebugSubst(const char* src) const
+void Field::DebugSubst(const Bitplanes* src, int pos) const
 {
-    if (!set->IsDebug(DBG_SUBST)) return;
+    if (!ctx->set->IsDebug(DBG_SUBST)) return;
     
     fprintf(stderr, "--- @X %03d(%02d) Set value ", offset, sz);
     for (int i=0; i<sz; i++)
-        fprintf(stderr,"%c", UN_OVL(src[i]));
+        fprintf(stderr,"%c", src->Bit(pos+i));
     fputc('\n', stderr);   
 }
 
@@ -111,19 +336,48 @@ CField::CField(int sz, int fm)
     : Field(sz), value(0), fmt(fm)
 {}
 
-/* stores bits in reversed order! */
-void CField::init_const(char* buf, int mod, int val, bool overlayable) const
-{
-    if (mod & FA_INV) val = ~val;
-    if (mod & FA_NEG) val = -val;
-    if (mod & FM_INV) val = ~val;
-    if (mod & FM_NEG) val = -val;
-    for (int i=0; i<16; i++) {
-        buf[i] = (val & 1) ? '1' : '0';
-        if (overlayable) buf[i] = OVL(buf[i]);
-        val >>= 1;
+/* the inversions and negations of attributes and modifiers are applied
+ * in the order FA_INV, FA_NEG, FM_INV, FM_NEG. Since ~v == -v-1, any chain
+ * of them is v*mul+add with mul = +-1 */
+void CField::fold(int mod, unsigned* mul, unsigned* add)
+{
+    unsigned m = 1, a = 0;
+    if (mod & FA_INV) { m = -m; a = ~a; }
+    if (mod & FA_NEG) { m = -m; a = -a; }
+    if (mod & FM_INV) { m = -m; a = ~a; }
+    if (mod & FM_NEG) { m = -m; a = -a; }
+    *mul = m;
+    *add = a;
+}
+
+/* overlay a constant of sz bits at pos. A constant has at most 16 bits,
+ * a wider field gets undefined bits in front of it */
+bool CField::insert(Bitplanes* buf, int pos, int sz, unsigned val, bool overlayable)
+{
+    int n = sz < 16 ? sz : 16;
+    for (int i=0; i < sz-n; i += LIMB_BITS) {
+        int k = sz-n-i < LIMB_BITS ? sz-n-i : LIMB_BITS;
+        if (!buf->Overlay(pos+i, k, ~0ULL, 0, 0)) return false;
     }
-    buf[16] = 0;
+    return buf->Overlay(pos+sz-n, n, val, ~0ULL, overlayable ? ~0ULL : 0);
+}
+
+bool CField::put_const(Bitplanes* buf, int pos, int mod, int val, bool overlayable) const
+{
+    unsigned m, a;
+    fold(mod, &m, &a);
+    return insert(buf, pos, sz, (unsigned)val * m + a, overlayable);
+}
+
+/* overlay the constant fd at pos, like a CField(fd, pos) would,
+ * without building one */
+bool CField::Put(Bitplanes* buf, int pos, const Fdecl& fd)
+{
+    if (fd.sz == 0) internal_error(__FILE__, __LINE__);
+
+    unsigned m, a;
+    fold(fd.fmt, &m, &a);
+    return insert(buf, pos, fd.sz, (unsigned)fd.value * m + a, false);
 }
 
 CField::CField(const Fdecl& fd, int off)
@@ -132,10 +386,10 @@ CField::CField(const Fdecl& fd, int off)
     if (sz == 0) internal_error(__FILE__, __LINE__);
     
     offset = off;
-    map = mkbuf(17, '\0'); // maximal size of constant
+    map = new Bitplanes(sz, OVL('X'));
     
     /* constant modifiers are handled. value itself is as defined */
-    init_const(map, fmt, value, false);
+    put_const(map, 0, fmt, value, false);
 }
 
 CField::CField(const CField& org)
@@ -166,32 +420,18 @@ int CField::Bitsize(const char* txt, int value, int base)
     }
 }
 
-bool CField::copy_rev(char* tgt, const char* src) const
+void CField::DebugSubst(const Bitplanes* src, int pos) const
 {
-    DebugSubst(src);
-    for (int i=0; i<sz; i++) {
-        if (!copy_bit(&tgt[offset+i], &src[sz-i-1])) return false;
-    }
-    return true;
-}
-
-void CField::DebugSubst(const char* src) const
-{
-    if (!set->IsDebug(DBG_SUBST)) return;
+    if (!ctx->set->IsDebug(DBG_SUBST)) return;
 
     fprintf(stderr,"--- @%c %03d(%02d) Set value ", 
             IsVField() ? 'V' : 'C', offset, sz);
     for (int i=0; i<sz; i++) {
-        fprintf(stderr,"%c", UN_OVL(src[sz-i-1]));
+        fprintf(stderr,"%c", src->Bit(pos+i));
     }
     fputc('\n', stderr);
 }
 
-bool CField::Init(char* buf) const
-{
-    return copy_rev(buf, map);
-}
-
 void CField::DebugConst(int fm, int val, int siz, bool putsize)
 {
     int base = fm & F_MASK;
@@ -251,10 +491,11 @@ VField::VField(const Fdecl& fd, int off)
     
     offset = off;
     
-    map = mkbuf(17, (fmt & FA_XINI) ? OVL('X') : OVL(0));
+    map = new Bitplanes(sz, (fmt & FA_XINI) ? OVL('X') : OVL(0));
     
     if (fmt & FA_VAL)
-        init_const(map, fmt, fd.value, true);
+        put_const(map, 0, fmt, fd.value, true);
+    bind();
 }
 
 VField::VField(const VField& org)
@@ -262,33 +503,61 @@ VField::VField(const VField& org)
 {
     offset = org.offset;
     value = org.value;
-    map = mkbuf(17, '\0');
-    memcpy(map, org.map, 17);
+    map = new Bitplanes(*org.map);
+    bind();
 }
 
-bool VField::Init(char* buf) const
+/* precompute the substitution of an argument: the attributes of the field
+ * are known in phase 1, so Subst only has to multiply and add */
+void VField::bind()
 {
-    if (!copy_rev(buf, map)) return false;
-    for (int i=0; i<sz; i++)
-        buf[offset+i] = OVL(buf[offset+i]);
+    fold(fmt, &mul, &add);
+}
+
+bool VField::Init(Bitplanes* buf) const
+{
+    if (!overlay(buf)) return false;
+    buf->SetOvl(offset, sz);
     return true;
 }
 
-bool VField::Subst(char* buf, const Fdecl& arg) const
+bool VField::Subst(Bitplanes* buf, const Fdecl& arg) const
 {
-    char argbuf[17]; argbuf[16] = '\0';
-    
-    if (set->IsDebug(DBG_SUBST)) {
+    if (ctx->set->IsDebug(DBG_SUBST)) {
         fprintf(stderr,"--- @V %03d(%02d) Initvalue ", offset, sz);
         for (int i=0; i<sz; i++) {
-            fprintf(stderr,"%c", UN_OVL(buf[offset+i]));
+            fprintf(stderr,"%c", buf->Bit(offset+i));
         }
         fputc('\n', stderr);
+
+        Bitplanes argbuf(sz, OVL('X'));
+        put_const(&argbuf, 0, arg.fmt | fmt, arg.value, false);
+        DebugSubst(&argbuf);
     }
 
-    /* attributes and modifiers are handled in init_const */
-    init_const(argbuf, arg.fmt | fmt, arg.value, false);
-    return copy_rev(buf, argbuf);
+    /* an argument with modifiers of its own needs the full fold */
+    unsigned m = mul, a = add;
+    if (arg.fmt & ~fmt & (FA_INV|FA_NEG|FM_INV|FM_NEG))
+        fold(arg.fmt | fmt, &m, &a);
+    if (!insert(buf, offset, sz, (unsigned)arg.value * m + a, false)) {
+        yyerror("Field is already set");
+        return false;
+    }
+    return true;
+}
+
+/* convert an untyped constant like "00E", using the base of this field */
+bool VField::Untyped(const char* name, Fdecl* res) const
+{
+    int base = GetBase();
+    if (base == 0) {
+        yyerror("Invalid substitution");
+        return false;
+    }
+    int val = strtol(name, 0, base); /* convert number */
+    res->Set(base, sz, val);
+    res->FixSize();
+    return true;
 }
 
 void VField::Debug(bool dummy) const
@@ -30,6 +30,7 @@
 /*define the field type */
 #define F_DC    0x80000000
 #define F_VAR   0x40000000
+#define F_FWD   0x20000000      /* unresolved forward reference (single pass) */
 
 /* define the V attr */
 #define FA_INV	0x00010000		/* * inversion */
@@ -65,33 +66,92 @@ struct Fdecl
 #define IS_OVL(x) (((x) & 0x80)==0x80)
 #define UN_OVL(x) ((x) & 0x7f)
 
+/*forward*/ class Arena;
+
+typedef unsigned long long Limb;
+#define LIMB_BITS   64
+#define LIMBS(n)    (((n) + LIMB_BITS-1) / LIMB_BITS)
+#define LIMB_MASK(n) ((n) >= LIMB_BITS ? ~0ULL : (1ULL << (n)) - 1)
+
+/* A microword, or the image of a field, as three planes of bits.
+ * Bit 0 is the leftmost, and the MSB of the first limb, so that a
+ * span of up to 64 bits reads like a number. A bit is '1' if set in
+ * val and def, '0' if set in def only, and 'X' if set in neither.
+ * A bit set in val only is undefined: a VFS without default has
+ * these until an argument is substituted, they print as NUL.
+ * ovl marks the bits that may be overwritten. */
+class Bitplanes
+{
+protected:
+    int sz;
+    int nl;             /* limbs per plane */
+    Limb* val;          /* the planes are consecutive */
+    Limb* def;
+    Limb* ovl;
+    Limb* mem;          /* owned storage, 0 for an arena or a view */
+
+    static Limb get(const Limb* p, int pos, int n);
+    static void put(Limb* p, int pos, int n, Limb v);
+    void alloc(int size, Arena* a=0);
+    void fill(int c);
+    bool overlay_limbs(const Bitplanes* src, int i);
+    friend class Cache;
+    friend class Words;
+public:
+    Bitplanes(int size, int c);
+    Bitplanes(int size, int c, Arena* a);
+    Bitplanes(int size, Limb* planes);
+    Bitplanes(const Bitplanes& org);
+    ~Bitplanes();
+
+    int Size() const { return sz; }
+    int Bit(int i) const;
+    char* Text(char* p, int pos, int n) const;
+    Limb Get(int pos, int n) const { return get(val, pos, n) & get(def, pos, n); }
+    Limb GetX(int pos, int n) const { return ~(get(val, pos, n) | get(def, pos, n)) & LIMB_MASK(n); }
+
+    bool Overlay(int pos, int n, Limb v, Limb d, Limb o);
+    bool Overlay(int pos, const Bitplanes* src);
+    bool Overlay(const Bitplanes* src);
+    bool Merge(const Bitplanes* src, const Bitplanes* force);
+    void SetOvl(int pos, int n);
+};
+
 /*forward*/ class CField;
 
+/* field kinds, see Field::IsA */
+#define FISA_DC     1
+#define FISA_CONST  2
+#define FISA_VAR    3
+
 /* baseclass, stores a don't care field */
 class Field
 {
 protected:
     int sz;
-    char* map;
+    Bitplanes* map;
     int offset;
+    Bitplanes* image;   /* map placed at offset in a word, see SetOffset */
     
     Field(int siz);
-    char* mkbuf(int size, int defval);
-    bool copy_bit(char* tgt, const char* src) const;
+    bool overlay(Bitplanes* tgt) const;
+    friend class Cache;
 public:
     Field(const Fdecl& fd, int off=0);
     Field(const Field& org);
     virtual ~Field();
 
     int Size() const { return sz; }
+    const Bitplanes* Map() const { return map; }
 
-    void SetOffset(int off) { offset = off; }
+    void SetOffset(int off);
     int Offset() const { return offset; }
     
+    virtual int IsA() const { return FISA_DC; }
     virtual bool IsVField() const { return false; }
-    virtual bool Init(char* buf) const;
+    virtual bool Init(Bitplanes* buf) const;
     virtual void Debug(bool dummy=true) const; 
-    virtual void DebugSubst(const char* src) const; 
+    virtual void DebugSubst(const Bitplanes* src, int pos=0) const; 
     virtual Field* Clone() const { return new Field(*this); }
 };
 
@@ -103,8 +163,10 @@ protected:
     int fmt;
     
     CField(int sz, int fmt);
-    void init_const(char* buf, int mod, int value, bool overlayable) const;
-    bool copy_rev(char* tgt, const char* src) const;
+    static void fold(int mod, unsigned* mul, unsigned* add);
+    static bool insert(Bitplanes* buf, int pos, int sz, unsigned val, bool overlayable);
+    bool put_const(Bitplanes* buf, int pos, int mod, int value, bool overlayable) const;
+    friend class Cache;
 public:
     CField(const Fdecl& fd, int off=0);
     CField(const CField& org);
@@ -114,11 +176,12 @@ public:
     static int DecBitsize(int value);
     static void DebugConst(int fmt, int value, int siz, bool putsize);
     static bool ResolveDecimal(const char* name, Fdecl* res);
+    static bool Put(Bitplanes* buf, int pos, const Fdecl& fd);
     
+    int IsA() const { return FISA_CONST; }
     bool IsVField() const { return false; }
-    bool Init(char* buf) const;
     void Debug(bool putsize=true) const;
-    void DebugSubst(const char* src) const; 
+    void DebugSubst(const Bitplanes* src, int pos=0) const; 
     Field* Clone() const { return new CField(*this); }
     int GetBase() const { return fmt & F_MASK; }
 };
@@ -126,14 +189,19 @@ public:
 /* stores a Var field, optionally with a default value */
 class VField : public CField
 {
+    unsigned mul, add;  /* attributes folded into val*mul+add, see bind */
+
+    void bind();
 public:
     VField(const Fdecl& fd, int off=0);
     VField(const VField& org);
     ~VField() {}
     
+    int IsA() const { return FISA_VAR; }
     bool IsVField() const { return true; }
-    bool Init(char* buf) const;
-    bool Subst(char* buf, const Fdecl& arg) const;
+    bool Init(Bitplanes* buf) const;
+    bool Subst(Bitplanes* buf, const Fdecl& arg) const;
+    bool Untyped(const char* name, Fdecl* res) const;
     void Debug(bool dummy=true) const;
     Field* Clone() const { return new VField(*this); }
 };    
@@ -0,0 +1,103 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "amdasm.h"
+
+Idents::Idents()
+    : size(IDENTS_INITSIZE), count(0), nids(0)
+{
+    slot = new Ident*[size];
+    memset(slot, 0, size * sizeof(Ident*));
+}
+
+Idents::~Idents()
+{
+    delete[] slot;
+}
+
+/* FNV-1a of the lower case text, names are case insensitive */
+unsigned int Idents::Hash(const char* s, int len)
+{
+    unsigned int h = 2166136261U;
+    for (int i=0; i<len; i++) {
+        h ^= (unsigned char)tolower(s[i]);
+        h *= 16777619U;
+    }
+    return h;
+}
+
+void Idents::grow()
+{
+    Ident** old = slot;
+    int oldsize = size;
+    size *= 2;
+    slot = new Ident*[size];
+    memset(slot, 0, size * sizeof(Ident*));
+    for (int i=0; i<oldsize; i++) {
+        if (old[i] == 0) continue;
+        int k = old[i]->hash & (size-1);
+        while (slot[k]) k = (k+1) & (size-1);
+        slot[k] = old[i];
+    }
+    delete[] old;
+}
+
+/* the entry of this spelling; a new spelling of a known name gets its id */
+const Ident* Idents::Intern(const char* s, int len)
+{
+    unsigned int h = Hash(s, len);
+    int id = -1;
+    int k = h & (size-1);
+    for (; slot[k]; k = (k+1) & (size-1)) {
+        const Ident* nm = slot[k];
+        if (nm->hash != h) continue;
+        if (!strncmp(nm->text, s, len) && nm->text[len] == '\0')
+            return nm;
+        if (id < 0 && !strncasecmp(nm->text, s, len) && nm->text[len] == '\0')
+            id = nm->id;
+    }
+    if (2*(count+1) > size) {
+        grow();
+        k = h & (size-1);
+        while (slot[k]) k = (k+1) & (size-1);
+    }
+
+    Ident* nm = (Ident*)arena.Alloc(sizeof(Ident));
+    nm->text = Copy(s, len);
+    nm->hash = h;
+    nm->id = id >= 0 ? id : nids++;
+    slot[k] = nm;
+    count++;
+    return nm;
+}
+
+/* id of a name in any spelling, or -1 if it was never seen */
+int Idents::Id(const char* s) const
+{
+    int len = strlen(s);
+    unsigned int h = Hash(s, len);
+    for (int k = h & (size-1); slot[k]; k = (k+1) & (size-1)) {
+        const Ident* nm = slot[k];
+        if (nm->hash == h && !strcasecmp(nm->text, s)) return nm->id;
+    }
+    return -1;
+}
+
+char* Idents::Copy(const char* s, int len)
+{
+    return arena.Copy(s, len);
+}
@@ -0,0 +1,57 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef __IDENTS_H__
+#define __IDENTS_H__
+
+/* An identifier as scanned. The text is kept as spelled; names which
+ * differ only in case have the same id, like the symbols they denote */
+struct Ident
+{
+    const char* text;
+    unsigned int hash;  /* of the lower case text */
+    int id;             /* dense, in order of first occurrence */
+};
+
+/* The identifiers of one assembler run, interned by the scanner and by
+ * Symtab::Enter. Text and entries live in an arena which is released
+ * with the table. Phase 2b workers only read it. */
+#define IDENTS_INITSIZE  256
+class Idents
+{
+protected:
+    Ident** slot;       /* open addressing, doubled when half full */
+    int size;           /* power of 2 */
+    int count;
+    int nids;
+    Arena arena;
+
+    void grow();
+public:
+    Idents();
+    ~Idents();
+
+    int Ids() const { return nids; }
+
+    const Ident* Intern(const char* s, int len);
+    int Id(const char* s) const;
+    char* Copy(const char* s, int len);
+
+    static unsigned int Hash(const char* s, int len);
+};
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "amdasm.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+
+Input::Input(const char* nam)
+    : next(ctx->iroot), buf(0), len(0), maplen(0)
+{
+    ctx->iroot = this;
+    name = copystr(nam);
+}
+
+Input::~Input()
+{
+#ifndef _WIN32
+    if (maplen) munmap(buf, maplen);
+    else
+#endif
+        delete[] buf;
+    delete[] name;
+}
+
+/* return the mapping of a file, map it on first use */
+Input* Input::Open(const char* name)
+{
+    for (Input* in = ctx->iroot; in; in = in->next)
+        if (!strcmp(in->name, name)) return in;
+
+    Input* in = new Input(name);
+    if (!in->load()) {
+        ctx->iroot = in->next;
+        delete in;
+        return 0;
+    }
+    return in;
+}
+
+/* enter a file whose contents are already in memory */
+Input* Input::Open(const char* name, const char* data, int size)
+{
+    Input* in = new Input(name);
+    in->buf = new char[size+2];
+    memcpy(in->buf, data, size);
+    in->buf[size] = in->buf[size+1] = '\0';
+    in->len = size;
+    return in;
+}
+
+#ifndef _WIN32
+/* map the file privately: flex writes its hold char into the buffer.
+ * An anonymous mapping behind the file provides the two NUL bytes, even
+ * if the file size is a multiple of the page size */
+bool Input::load()
+{
+    int fd = open(name, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        close(fd);
+        return false;
+    }
+    len = st.st_size;
+
+    long pg = sysconf(_SC_PAGESIZE);
+    maplen = ((long)len + 2 + pg - 1) / pg * pg;
+    void* mem = mmap(0, maplen, PROT_READ|PROT_WRITE,
+                     MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        close(fd);
+        maplen = 0;
+        return false;
+    }
+    if (len > 0 && 
+        mmap(mem, len, PROT_READ|PROT_WRITE,
+             MAP_PRIVATE|MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(mem, maplen);
+        close(fd);
+        maplen = 0;
+        return false;
+    }
+    close(fd);
+    buf = (char*)mem;
+    return true;
+}
+#else
+/* no mmap: read the file once into a buffer */
+bool Input::load()
+{
+    FILE* fd = fopen(name, "rb");
+    if (fd == 0) return false;
+    
+    fseek(fd, 0, SEEK_END);
+    len = ftell(fd);
+    fseek(fd, 0, SEEK_SET);
+    
+    buf = new char[len+2];
+    len = fread(buf, 1, len, fd);
+    buf[len] = buf[len+1] = '\0';
+    fclose(fd);
+    return true;
+}
+#endif
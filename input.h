@@ -0,0 +1,48 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef __INPUT_H__
+#define __INPUT_H__
+
+/* An input file, mapped into memory once and scanned in place by
+ * every phase that reads it. The buffer is followed by the two NUL
+ * bytes flex expects at the end of a scan buffer. Since the scanner
+ * writes into the buffer, each context has its own mappings. */
+class Input
+{
+protected:
+    Input* next;
+    char* name;
+    char* buf;
+    int len;
+    long maplen;    /* size of mapping, 0 if read into heap */
+
+    Input(const char* nam);
+    bool load();
+public:
+    ~Input();
+
+    static Input* Open(const char* name);
+    static Input* Open(const char* name, const char* data, int size);
+    Input* Next() const { return next; }
+
+    const char* Name() const { return name; }
+    char* Buffer() const { return buf; }
+    int Size() const { return len; }
+};
+
+#endif
@@ -0,0 +1,520 @@
+/* generated by miniflex (local test tool) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <regex>
+#include <vector>
+#define YY_END_OF_BUFFER_CHAR 0
+#define ECHO fwrite(yytext, yyleng, 1, stdout)
+#define YY_BREAK break;
+#define yyterminate() return 0
+typedef struct yy_buffer_state* YY_BUFFER_STATE;
+typedef size_t yy_size_t;
+struct yy_buffer_state { char* base; size_t size; bool owned; };
+typedef void* yyscan_t;
+#define YY_EXTRA_TYPE_DEFAULT void*
+#define YYSTATE yyg->start
+#define YY_START yyg->start
+#define BEGIN yyg->start = 
+
+struct yyguts_t {
+    void* extra;
+    FILE* in;
+    char* buf; size_t len; bool owned; bool inited;
+    char* cp; char hold;
+    char* text_r; int leng_r;
+    int start;
+    int debug;
+    void* lval;
+    YY_BUFFER_STATE cur;
+};
+
+#define yytext yyg->text_r
+#define yyleng yyg->leng_r
+#define yyin yyg->in
+#define yyextra ((YY_EXTRA_TYPE)yyg->extra)
+#define yylval ((YYSTYPE*)yyg->lval)
+struct yyguts_t; static void yyunput_impl(int c, struct yyguts_t* yyg);
+#define unput(c) yyunput_impl((c), yyg)
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+/* FLEX grammar for ASMASM */
+#include "amdasm.h"
+#include "data.h"
+#include "y.tab.h"
+
+#define YY_EXTRA_TYPE Context*
+#define YY_DECL int scan_token(YYSTYPE* yylval_param, yyscan_t yyscanner)
+
+/* collect text for the listing, and keep it on tape for phase 2b */
+#define PR      { yyextra->p->Collect(yytext, yyleng); \
+                  if (yyextra->tape) yyextra->tape->Text(yytext, yyleng); }
+#define FLUSH   { yyextra->p->Flush(); \
+                  if (yyextra->tape) yyextra->tape->Flush(); }
+
+static int yylval_str2(void* yyscanner, int token);
+static int yylval_str(void* yyscanner, int token);
+static int yylval_title(void* yyscanner);
+static int yylval_tok(void* yyscanner, int token);
+static int yylval_fmt(void* yyscanner);
+static int yylval_fdecl(void* yyscanner, int fmt, int token);
+static int yylval_sznum(void* yyscanner, int token);
+static int yylval_untyped(void* yyscanner);
+
+#define INITIAL 0
+#define title 1
+#define comment 2
+#define vx 3
+#ifndef YY_EXTRA_TYPE
+#define YY_EXTRA_TYPE void*
+#endif
+#define YYG_ARG , yyscan_t yyscanner
+static thread_local std::vector<std::regex>* yy_res;
+static const char* yy_pats[] = {";","[^\\n]*","TITLE","(?:[\\t\\r\\f ])[^;\\r\\n]+","(?:[0-9]*)B#[01]+","(?:[0-9]*)Q#[0-7]+","(?:[0-9]*)D#[0-9]+","(?:[0-9]*)H#[0-9A-F]+","(?:[0-9]+)X","(?:[0-9]+)V","X[BQDH]","X","[BQDH]#","(?:[A-Z\\.][A-Z0-9\\.]*)::","(?:[A-Z\\.][A-Z0-9\\.]*):","ALIGN","COLS","DEF","EJECT","END","EQU","FF","LIST","NOLIST","ORG","RES","SPACE","SUB","WORD","(?:[A-Z\\.][A-Z0-9\\.]*)","(?:[0-9][0-9A-F]*)","(?:\\n)/","(?:\\n)","\\+","-","\\*","/",",","&",":","%","\\$","\\(","\\)","\\{","\\|","\\}","(?:[\\t\\r\\f ])*"};
+static const int yy_active[][48] = {
+{1,0,1,0,1,1,1,1,1,1,0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1},
+{1,0,1,1,1,1,1,1,1,1,0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1},
+{1,1,1,0,1,1,1,1,1,1,0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1},
+{1,0,1,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1},
+};
+
+static std::vector<std::regex>* yy_make_res() {
+    std::vector<std::regex>* r = new std::vector<std::regex>();
+    for (size_t i = 0; i < sizeof(yy_pats)/sizeof(yy_pats[0]); i++)
+        r->push_back(std::regex(yy_pats[i], std::regex::ECMAScript | std::regex::icase));
+    return r;
+}
+static void yy_init_res() {
+    static std::vector<std::regex>* r = yy_make_res();
+    yy_res = r;
+}
+
+static void yyunput_impl(int c, struct yyguts_t* yyg) {
+    *yyg->cp = yyg->hold;
+    if (yyg->cp <= yyg->buf) { fprintf(stderr, "miniflex: unput overflow\n"); exit(2); }
+    *--yyg->cp = (char)c;
+    yyg->hold = *yyg->cp;
+    yyg->text_r = yyg->cp;
+    *yyg->cp = yyg->hold;
+}
+
+YY_BUFFER_STATE yy_scan_buffer(char* base, yy_size_t size, yyscan_t yyscanner) {
+    struct yyguts_t* yyg = (struct yyguts_t*)yyscanner;
+    if (size < 2 || base[size-1] || base[size-2]) return 0;
+    YY_BUFFER_STATE b = new yy_buffer_state; b->base = base; b->size = size - 2; b->owned = false;
+    yyg->buf = base; yyg->len = size - 2; yyg->cp = base; yyg->hold = *base; yyg->inited = true; yyg->cur = b;
+    return b;
+}
+YY_BUFFER_STATE yy_scan_bytes(const char* bytes, int len, yyscan_t yyscanner) {
+    struct yyguts_t* yyg = (struct yyguts_t*)yyscanner;
+    char* base = (char*)malloc(len + 2 + 16) + 16;
+    memcpy(base, bytes, len); base[len] = base[len+1] = 0;
+    YY_BUFFER_STATE b = new yy_buffer_state; b->base = base; b->size = len; b->owned = true;
+    yyg->buf = base; yyg->len = len; yyg->cp = base; yyg->hold = *base; yyg->inited = true; yyg->cur = b;
+    return b;
+}
+YY_BUFFER_STATE yy_scan_string(const char* s, yyscan_t yyscanner) {
+    return yy_scan_bytes(s, strlen(s), yyscanner);
+}
+void yy_delete_buffer(YY_BUFFER_STATE b, yyscan_t yyscanner) {
+    struct yyguts_t* yyg = (struct yyguts_t*)yyscanner;
+    if (!b) return;
+    if (yyg->cur == b) { yyg->cur = 0; yyg->inited = false; yyg->buf = 0; }
+    if (b->owned) free(b->base - 16);
+    delete b;
+}
+
+
+int yylex_init(yyscan_t* s) { struct yyguts_t* g = (struct yyguts_t*)calloc(1, sizeof(struct yyguts_t)); *s = g; return 0; }
+int yylex_init_extra(YY_EXTRA_TYPE e, yyscan_t* s) { yylex_init(s); ((struct yyguts_t*)*s)->extra = (void*)e; return 0; }
+int yylex_destroy(yyscan_t s) { free(s); return 0; }
+void yyset_extra(YY_EXTRA_TYPE e, yyscan_t s) { ((struct yyguts_t*)s)->extra = (void*)e; }
+YY_EXTRA_TYPE yyget_extra(yyscan_t s) { return (YY_EXTRA_TYPE)((struct yyguts_t*)s)->extra; }
+void yyset_debug(int d, yyscan_t s) { ((struct yyguts_t*)s)->debug = d; }
+int yyget_debug(yyscan_t s) { return ((struct yyguts_t*)s)->debug; }
+void yyset_in(FILE* f, yyscan_t s) { ((struct yyguts_t*)s)->in = f; }
+char* yyget_text(yyscan_t s) { return ((struct yyguts_t*)s)->text_r; }
+int yyget_leng(yyscan_t s) { return ((struct yyguts_t*)s)->leng_r; }
+
+#ifdef YY_DECL
+YY_DECL
+#else
+int yylex(YYSTYPE* yylval_param, yyscan_t yyscanner)
+#endif
+{
+    struct yyguts_t* yyg = (struct yyguts_t*)yyscanner;
+    yyg->lval = yylval_param;
+    yy_init_res();
+    if (!yyg->inited) {
+        /* read all of yyin */
+        FILE* f = yyg->in ? yyg->in : stdin;
+        size_t cap = 4096, n = 0; char* b = (char*)malloc(cap + 16);
+        int c;
+        while ((c = fgetc(f)) != EOF) { if (n + 3 >= cap) { cap *= 2; b = (char*)realloc(b, cap + 16); } b[16 + n++] = c; }
+        b[16+n] = b[16+n+1] = 0;
+        yyg->buf = b + 16; yyg->len = n; yyg->cp = yyg->buf; yyg->hold = *yyg->cp; yyg->inited = true; yyg->owned = true; yyg->cur = 0;
+    }
+
+    for (;;) {
+        *yyg->cp = yyg->hold;
+        char* end = yyg->buf + yyg->len;
+        if (yyg->cp >= end) {
+            if (!yyg->cur) yyg->inited = false;
+            yyg->text_r = yyg->cp; yyg->leng_r = 0;
+            { return 0; }
+            return 0;
+        }
+        int best = -1; long bestlen = 0;
+        for (size_t r = 0; r < yy_res->size(); r++) {
+            if (!yy_active[yyg->start][r]) continue;
+            std::cmatch m;
+            if (std::regex_search((const char*)yyg->cp, (const char*)end, m, (*yy_res)[r], std::regex_constants::match_continuous)) {
+                long l = m.length(0);
+                if (l > bestlen) { bestlen = l; best = r; }
+            }
+        }
+        char* bp = yyg->cp;
+        if (best < 0) { bestlen = 1; }
+        yyg->text_r = bp; yyg->leng_r = bestlen;
+        yyg->cp = bp + bestlen;
+        yyg->hold = *yyg->cp; *yyg->cp = 0;
+        switch (best) {
+        case -1: ECHO; break;
+        case 0:
+        { { PR; BEGIN comment; } }
+        break;
+        case 1:
+        { { PR; BEGIN 0; } }
+        break;
+        case 2:
+        { { if (yyextra->iskwd) BEGIN title;
+                          else return yylval_str(yyscanner, NAME); } }
+        break;
+        case 3:
+        { { BEGIN 0; return yylval_title(yyscanner); } }
+        break;
+        case 4:
+        { { PR; return yylval_sznum(yyscanner, CONST); } }
+        break;
+        case 5:
+        { { PR; return yylval_sznum(yyscanner, CONST); } }
+        break;
+        case 6:
+        { { PR; return yylval_sznum(yyscanner, CONST); } }
+        break;
+        case 7:
+        { { PR; return yylval_sznum(yyscanner, CONST); } }
+        break;
+        case 8:
+        { { PR; return yylval_fdecl(yyscanner, F_DC,  DCFIELD); } }
+        break;
+        case 9:
+        { { PR; BEGIN vx; return yylval_fdecl(yyscanner, F_VAR, VARFIELD); } }
+        break;
+        case 10:
+        { { PR; BEGIN 0; unput(yytext[1]); return XOPT; } }
+        break;
+        case 11:
+        { { PR; BEGIN 0; return XOPT; } }
+        break;
+        case 12:
+        { { PR; return yylval_fmt(yyscanner); } }
+        break;
+        case 13:
+        { { PR; return yylval_str2(yyscanner, ENTRY); } }
+        break;
+        case 14:
+        { { PR; return yylval_str2(yyscanner, LABEL); } }
+        break;
+        case 15:
+        { { PR; return yylval_tok(yyscanner, ALIGN); } }
+        break;
+        case 16:
+        { { PR; return yylval_tok(yyscanner, COLS); /* extension */ } }
+        break;
+        case 17:
+        { { PR; return yylval_tok(yyscanner, DEF); } }
+        break;
+        case 18:
+        { {     return yylval_tok(yyscanner, EJECT); } }
+        break;
+        case 19:
+        { { PR; return yylval_tok(yyscanner, END); } }
+        break;
+        case 20:
+        { { PR; return yylval_tok(yyscanner, EQU); } }
+        break;
+        case 21:
+        { { PR; return yylval_tok(yyscanner, FF); } }
+        break;
+        case 22:
+        { {     return yylval_tok(yyscanner, LIST); } }
+        break;
+        case 23:
+        { {     return yylval_tok(yyscanner, NOLIST); } }
+        break;
+        case 24:
+        { { PR; return yylval_tok(yyscanner, ORG); } }
+        break;
+        case 25:
+        { { PR; return yylval_tok(yyscanner, RES); } }
+        break;
+        case 26:
+        { {     return yylval_tok(yyscanner, SPACE); } }
+        break;
+        case 27:
+        { { PR; return yylval_tok(yyscanner, SUB); } }
+        break;
+        case 28:
+        { { PR; return WORD; } }
+        break;
+        case 29:
+        { { PR; return yylval_str(yyscanner, NAME); } }
+        break;
+        case 30:
+        { { PR; return yylval_untyped(yyscanner); } }
+        break;
+        case 31:
+        { { PR; FLUSH; PR; /* continuation line */ } }
+        break;
+        case 32:
+        { { FLUSH; yyextra->iskwd = true; BEGIN 0;
+                          yyextra->lineptr = yytext + yyleng; return NL; } }
+        break;
+        case 33:
+        { { PR; return PLUS; } }
+        break;
+        case 34:
+        { { PR; return MINUS; } }
+        break;
+        case 35:
+        { { PR; return TIMES; } }
+        break;
+        case 36:
+        { { PR; return SLASH; } }
+        break;
+        case 37:
+        { { PR; return COMMA; } }
+        break;
+        case 38:
+        { { PR; return AMPERSAND; } }
+        break;
+        case 39:
+        { { PR; return COLON; } }
+        break;
+        case 40:
+        { { PR; return PERCENT; } }
+        break;
+        case 41:
+        { { PR; return DOLLAR; } }
+        break;
+        case 42:
+        { { PR; return LPAREN; } }
+        break;
+        case 43:
+        { { PR; return RPAREN; } }
+        break;
+        case 44:
+        { { yyextra->iskwd = true; return DEFMARK; } }
+        break;
+        case 45:
+        { { yyextra->iskwd = true; return SRCMARK1; } }
+        break;
+        case 46:
+        { { yyextra->iskwd = true; return SRCMARK2; } }
+        break;
+        case 47:
+        { { PR; } }
+        break;
+        }
+    }
+}
+
+static void scan_init(Context* ctx, int token)
+{
+    ctx->start_token = token;
+    ctx->iskwd = false;
+    if (yylex_init_extra(ctx, &ctx->scanner))
+        internal_error(__FILE__, __LINE__);
+    yyset_debug(ctx->set->IsDebug(DBG_LEX) ? 1 : 0, ctx->scanner);
+}
+
+/* scan a mapped input in place, no copy and no read() per refill */
+void scan_input(Context* ctx, Input* in, char marker)
+{
+    switch (marker) {
+    case '{':   scan_init(ctx, DEFMARK); break;
+    case '|':   scan_init(ctx, SRCMARK1); break;
+    case '}':   scan_init(ctx, SRCMARK2); break;
+    default:    internal_error(__FILE__, __LINE__);
+    }
+    ctx->scanbuf = yy_scan_buffer(in->Buffer(), in->Size() + 2, ctx->scanner);
+    if (ctx->scanbuf == 0) internal_error(__FILE__, __LINE__);
+}
+
+/* read the SRC tokens of phase 2a from tape entries first..last;
+ * whole is false for a part without END, see Chunk */
+void scan_tape(Context* ctx, int first, int last, bool whole)
+{
+    ctx->start_token = whole ? SRCMARK2 : SRCCHUNK;
+    ctx->replay = true;
+    ctx->tapepos = first;
+    ctx->tapeend = last;
+}
+
+void scan_end(Context* ctx)
+{
+    if (ctx->replay) {
+        ctx->replay = false;
+        return;
+    }
+    scan_free(ctx);
+}
+
+/* also for a scan left by fatal(), see ~Context */
+void scan_free(Context* ctx)
+{
+    if (ctx->scanbuf)
+        yy_delete_buffer((YY_BUFFER_STATE)ctx->scanbuf, ctx->scanner);
+    if (ctx->scanner)
+        yylex_destroy(ctx->scanner);
+    ctx->scanbuf = 0;
+    ctx->scanner = 0;
+}
+
+/* the pure parser calls this with the context of its run */
+int yylex(YYSTYPE* lval, Context* ctx)
+{
+    if (ctx->failed) return 0;  /* worker gave up */
+
+    /* the phase marker is the first token of a scan */
+    if (ctx->start_token) {
+        int tok = ctx->start_token;
+        ctx->start_token = 0;
+        ctx->iskwd = true;
+        return tok;
+    }
+    if (ctx->replay)
+        return ctx->tape->Replay(lval, ctx->p, &ctx->tapepos, ctx->tapeend);
+
+    int tok = scan_token(lval, ctx->scanner);
+    if (ctx->tape && tok) ctx->tape->Token(tok, lval);
+    return tok;
+}
+
+/* intern label/entry without the trailing colon(s) */
+static int yylval_str2(yyscan_t yyscanner, int token)
+{
+    struct yyguts_t* yyg = (struct yyguts_t*)yyscanner;
+	yylval->name = yyextra->idents->Intern(yytext, strchr(yytext,':') - yytext);
+    return token;
+}
+
+/* names are interned once, the parser works on the entry */
+static int yylval_str(yyscan_t yyscanner, int token)
+{
+    struct yyguts_t* yyg = (struct yyguts_t*)yyscanner;
+    yyextra->iskwd = false;  /* a string symbol will always terminate keyword mode */
+	yylval->name = yyextra->idents->Intern(yytext, yyleng);
+    return token;
+}
+
+static int yylval_title(yyscan_t yyscanner)
+{
+    struct yyguts_t* yyg = (struct yyguts_t*)yyscanner;
+    yyextra->iskwd = false;
+	yylval->str = yyextra->idents->Copy(yytext, yyleng);
+    return TITLE;
+}
+
+static int yylval_tok(yyscan_t yyscanner, int token)
+{
+    struct yyguts_t* yyg = (struct yyguts_t*)yyscanner;
+	if (yyextra->iskwd) {
+		yyextra->iskwd = false;
+		return token;
+	}
+    return yylval_str(yyscanner, NAME);
+}
+
+/* recognize format from [BQDH] */
+static int bqdh_to_base(const char* txt)
+{
+	switch (txt[0]) {
+	case 'B':	return 2;
+	case 'Q':	return 8;
+	case 'D':	return 10;
+	case 'H':	return 16;
+	default:	return internal_error(__FILE__, __LINE__);
+	}
+}
+
+static int yylval_fmt(yyscan_t yyscanner)
+{
+    struct yyguts_t* yyg = (struct yyguts_t*)yyscanner;
+	yylval->fmt = bqdh_to_base(yytext);
+	return DEFFMT;
+}
+
+/* start building a {sz}X or {sz}V field */
+static int yylval_fdecl(yyscan_t yyscanner, int fmt, int token)
+{
+    struct yyguts_t* yyg = (struct yyguts_t*)yyscanner;
+    yylval->fdecl.Set(fmt, atol(yytext), 0);
+	return token;
+}
+
+/* convert a number {optsz}[BQDH]#xxxxx */
+static int yylval_sznum(yyscan_t yyscanner, int token)
+{
+    struct yyguts_t* yyg = (struct yyguts_t*)yyscanner;
+    char* next;
+    int sz = strtol(yytext, &next, 10); 
+	int base = bqdh_to_base(next);
+    int value = strtol(next+2, 0, base);
+    int siz = sz ? sz : CField::Bitsize(next+2, value, base);
+    yylval->fdecl.Set(base, siz, value);
+    return token;
+}
+
+/* phase 2 accepts untyped constants for substitution, like "00E",
+ * handle these like a special name */
+static int yylval_untyped(yyscan_t yyscanner)
+{
+    struct yyguts_t* yyg = (struct yyguts_t*)yyscanner;
+	/* in phase 1 interpret 00E like a decimal number and bail out at the 'E' later */
+    if (yyextra->set->Phase() == 1) {
+		int value = atol(yytext);
+        const char* end = yytext + strlen(yytext);
+
+		/* advance to first non-digit */
+        char* txt = yytext;
+        while (isdigit(*txt)) txt++;
+
+		/* pushback everything after the number */
+        while (end > txt) unput(*--end);
+
+		/* and claim it is a decimal number */
+        yylval->fdecl.Set(F_DEC, CField::DecBitsize(value), value);
+        return NUMBER;
+    } else
+		/* phase 2 must deal with that mess */
+        return yylval_str(yyscanner, NAME);
+}
+
+
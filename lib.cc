@@ -0,0 +1,188 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <limits.h>
+#include "amdasm.h"
+
+Library::Library()
+    : maxerrors(0)
+{
+    res = new amdasm_result;
+    memset(res, 0, sizeof(amdasm_result));
+}
+
+/* frees a result that was not handed out */
+Library::~Library()
+{
+    amdasm_free(res);
+}
+
+void Library::Error(const char* file, int line, int col, const char* msg)
+{
+    if (res->nerrors == maxerrors) {
+        maxerrors = maxerrors ? 2*maxerrors : 16;
+        amdasm_error* e = new amdasm_error[maxerrors];
+        if (res->nerrors) memcpy(e, res->errors, res->nerrors * sizeof(amdasm_error));
+        delete[] res->errors;
+        res->errors = e;
+    }
+    amdasm_error* e = &res->errors[res->nerrors++];
+    e->file = copystr(file ? file : "");
+    e->line = line;
+    e->column = col;
+    e->message = copystr(msg);
+}
+
+int Library::by_address(const void* a, const void* b)
+{
+    const amdasm_label* la = (const amdasm_label*)a;
+    const amdasm_label* lb = (const amdasm_label*)b;
+    if (la->address != lb->address) return la->address - lb->address;
+    return strcmp(la->name, lb->name);
+}
+
+/* pack the generated microwords and copy the labels */
+void Library::Collect(Context* cx)
+{
+    int w = cx->set->WordSize();
+    int nb = (w + 7) / 8;
+    Words* words = cx->words;
+    int n = words ? words->Count() : 0;
+
+    res->wordsize = w;
+    res->wordbytes = nb;
+    res->nwords = n;
+    res->address = new int[n];
+    res->bits = new unsigned char[n*nb];
+    res->xmask = new unsigned char[n*nb];
+    memset(res->bits, 0, n*nb);
+    memset(res->xmask, 0, n*nb);
+
+    /* same bit order as the byte dump formats: first byte is partial */
+    for (n = 0; n < res->nwords; n++) {
+        Bitplanes line(w, words->Planes(n));
+        res->address[n] = words->Address(n);
+        unsigned char* bits = res->bits + n*nb;
+        unsigned char* xmask = res->xmask + n*nb;
+        int rest = nb*8 - w;    /* unused bits at the MSB of first byte */
+        for (int k=0; k<nb; k++) {
+            int pos = k ? k*8 - rest : 0;
+            int n = k ? 8 : 8 - rest;
+            bits[k] = line.Get(pos, n);
+            xmask[k] = line.GetX(pos, n);
+        }
+    }
+
+    Symtab* tab = cx->labels;
+    n = tab->Count();
+    res->nlabels = n;
+    res->labels = new amdasm_label[n];
+    n = 0;
+    for (Symbol* s = tab->First(); s; s = s->Next(), n++) {
+        res->labels[n].name = copystr(s->Name());
+        res->labels[n].address = s->GetValue().value;
+        res->labels[n].entry = s->IsEntry();
+    }
+    qsort(res->labels, n, sizeof(amdasm_label), by_address);
+}
+
+amdasm_result* Library::Result(int status)
+{
+    amdasm_result* r = res;
+    r->status = status;
+    res = 0;
+    return r;
+}
+
+/****************************************************************************/
+
+/* Input adds the two NUL bytes for flex to the int size */
+static bool bad_length(long len)
+{
+    return len < 0 || len > INT_MAX - 2;
+}
+
+amdasm_result* amdasm_assemble(const char* defname, const char* def, long deflen,
+                               const char* srcname, const char* src, long srclen,
+                               int flags, int jobs)
+{
+    /* bad arguments are reported in the result like any other error */
+    const char* bad = 0;
+    const char* file = 0;
+    if (defname == 0 || srcname == 0)
+        bad = "Missing file name";
+    else if (def == 0 || src == 0) {
+        file = def ? srcname : defname;
+        bad = "Missing file contents";
+    } else if (bad_length(deflen) || bad_length(srclen)) {
+        file = bad_length(deflen) ? defname : srcname;
+        bad = "Invalid file size";
+    }
+    if (bad) {
+        Library* lib = new Library();
+        lib->Error(file, 0, 0, bad);
+        amdasm_result* res = lib->Result(2);
+        delete lib;
+        return res;
+    }
+
+    Context* cur = ctx;
+    Context* cx = ctx = new Context();
+    Library* lib = new Library();
+    jmp_buf env;
+    cx->lib = lib;
+    cx->bailout = &env;
+
+    Settings* set = cx->set;
+    set->SetDefFile(defname);
+    set->SetSrcFile(srcname);
+    set->SetNoList(true);
+    set->SetSinglePass(flags & AMDASM_SINGLEPASS);
+    set->SetJobs(jobs);
+    Input::Open(set->DefFile(), def, deflen);
+    Input::Open(set->SrcFile(), src, srclen);
+
+    /* fatal() returns here with the exit code */
+    int status = setjmp(env);
+    if (status == 0) {
+        status = cx->Run() ? 1 : 0;
+        if (status == 0) lib->Collect(cx);
+    }
+
+    delete cx;
+    ctx = cur;
+    amdasm_result* res = lib->Result(status);
+    delete lib;
+    return res;
+}
+
+void amdasm_free(amdasm_result* res)
+{
+    if (res == 0) return;
+    for (int i=0; i<res->nlabels; i++)
+        delete[] res->labels[i].name;
+    for (int i=0; i<res->nerrors; i++) {
+        delete[] res->errors[i].file;
+        delete[] res->errors[i].message;
+    }
+    delete[] res->address;
+    delete[] res->bits;
+    delete[] res->xmask;
+    delete[] res->labels;
+    delete[] res->errors;
+    delete res;
+}
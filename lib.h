@@ -0,0 +1,38 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef __LIB_H__
+#define __LIB_H__
+
+/* collects the result of a libamdasm call, see libamdasm.h */
+class Library
+{
+protected:
+    amdasm_result* res;
+    int maxerrors;
+
+    static int by_address(const void* a, const void* b);
+public:
+    Library();
+    ~Library();
+
+    void Error(const char* file, int line, int col, const char* msg);
+    void Collect(Context* cx);
+    amdasm_result* Result(int status);
+};
+
+#endif
@@ -0,0 +1,71 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef __LIBAMDASM_H__
+#define __LIBAMDASM_H__
+
+/* C interface of libamdasm: assemble a DEF and a SRC file that are
+ * in memory, without listing or output files. The process is never
+ * exited; errors are returned in the result. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct amdasm_label {
+    const char* name;
+    int address;
+    int entry;                  /* declared as ENTRY */
+} amdasm_label;
+
+typedef struct amdasm_error {
+    const char* file;
+    int line;                   /* 0 if not related to a line */
+    int column;
+    const char* message;
+} amdasm_error;
+
+typedef struct amdasm_result {
+    int status;                 /* exit code of amdasm: 0, 1, 2, or 99;
+                                 * 2 for invalid arguments */
+    int wordsize;               /* bits per microword */
+    int wordbytes;              /* bytes per packed microword */
+    int nwords;
+    int* address;               /* address of each microword */
+    unsigned char* bits;        /* microwords, most significant byte first,
+                                 * X bits as 0 */
+    unsigned char* xmask;       /* same layout, 1 for X bits */
+    int nlabels;
+    amdasm_label* labels;       /* sorted by address */
+    int nerrors;
+    amdasm_error* errors;
+} amdasm_result;
+
+/* flags */
+#define AMDASM_SINGLEPASS   1   /* like option -s */
+
+/* names are used in error messages; jobs is like option -j */
+amdasm_result* amdasm_assemble(const char* defname, const char* def, long deflen,
+                               const char* srcname, const char* src, long srclen,
+                               int flags, int jobs);
+void amdasm_free(amdasm_result* res);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
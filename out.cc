@@ -16,6 +16,7 @@
  *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 #include "amdasm.h"
+#include <new>
 
 ColMap::ColMap()
     : ncols(0), sz(0)
@@ -29,61 +30,64 @@ void ColMap::AddColumn(int siz)
     sz += siz;
 }
 
-void ColMap::DumpLine(FILE* fd, const char* line) const
+char* ColMap::Text(char* p, const Bitplanes* line) const
 {
-    int w = set->WordSize();
-    if (ncols==0) ((ColMap*)this)->AddColumn(w);
+    /* without COLS a single column; the writers only read */
+    int w = ctx->set->WordSize();
+    if (ncols==0) {
+        p = line->Text(p, 0, w);
+        *p++ = '\n';
+        return p;
+    }
 
     int i = 0;
     for (int n = ncols-1; n >= 0; n--) {
-        if (i > 0) fputc(' ', fd);
+        if (i > 0) *p++ = ' ';
         if (i == w) break;
-        for (int k = 0; k < col[n]; k++)
-            fputc(UN_OVL(line[i++]), fd);
+        p = line->Text(p, i, col[n]);
+        i += col[n];
     }
-    fputc('\n', fd);
+    *p++ = '\n';
+    return p;
 }
 
-Lineout* Lineout::root = 0;
-bool Lineout::revflag = false;
-
 Lineout::Lineout()
-    : next(Lineout::root), line(0), curdef(0), curvfs(0)
+    : next(ctx->lroot), line(0), curdef(0), curvfs(0)
 {
-    Lineout::root = this;
-    sz = set->WordSize();
-    address = set->LocPtr();
-    line = new char[sz+1]; line[sz] = '\0';
-    memset(line, OVL('X'), sz);
+    ctx->lroot = this;
+    sz = ctx->set->WordSize();
+    address = ctx->set->LocPtr();
+    line = new (ctx->arena->Alloc(sizeof(Bitplanes))) Bitplanes(sz, OVL('X'), ctx->arena);
     DebugSubst(SUB_NEWLINE);
 }
 
-Lineout::~Lineout()
+/* lines are released with the arena of the run */
+void* Lineout::operator new(size_t n)
 {
-    delete line;
+    return ctx->arena->Alloc(n);
 }
 
 /* Hey, my LISP finally yields fruit - reversing a list! */
 Lineout* Lineout::reverse()
 {
-    if (root && !Lineout::revflag) { /* ensure it is done once only */
+    if (ctx->lroot && !ctx->lrevflag) { /* ensure it is done once only */
         Lineout* nroot = 0;
-        for (Lineout* r = root; r; ) {
+        for (Lineout* r = ctx->lroot; r; ) {
             Lineout* n = r->next;
             r->next = nroot;
             nroot = r;
             r = n;
         }
-        root = nroot;
-        revflag = true;
+        ctx->lroot = nroot;
+        ctx->lrevflag = true;
     }
-    return Lineout::root;
+    return ctx->lroot;
 }
 
 /* set the current prototype def */
-bool Lineout::SetOverlayFormat(const char* name)
+bool Lineout::SetOverlayFormat(const Ident* name)
 {
-    Symbol *def = symtab->Lookup(name);
+    Symbol *def = ctx->symtab->Lookup(name);
     if (def && def->IsA()==ISA_DEF) {
         curdef = (Def*)def;
         curvfs = 0;
@@ -95,11 +99,33 @@ bool Lineout::SetOverlayFormat(const char* name)
     return curdef->Init(line);
 }
 
-bool Lineout::SubstField(const Field* fi)
+/* overlay a constant FF field. Only a trace needs the CField */
+bool Lineout::SubstField(const Fdecl& val, int off)
+{
+    if ((off + val.sz) > sz)
+        return false;
+    if (ctx->set->IsDebug(DBG_SUBST)) {
+        CField xc(val, off);
+        return xc.Init(line);
+    }
+    if (!CField::Put(line, off, val)) {
+        yyerror("Field is already set");
+        return false;
+    }
+    return true;
+}
+
+/* a DC field of FF is all overlayable X, so it cannot change the line */
+bool Lineout::SubstDC(const Fdecl& val, int off)
 {
-    if ((fi->Offset() +fi->Size()) > sz)
+    if (val.sz == 0) internal_error(__FILE__, __LINE__);
+    if ((off + val.sz) > sz)
         return false;
-    return fi->Init(line);
+    if (ctx->set->IsDebug(DBG_SUBST)) {
+        Field xf(val, off);
+        return xf.Init(line);
+    }
+    return true;
 }
 
 /* substitute arg # n in current prototype and overlay result */
@@ -112,11 +138,16 @@ bool Lineout::SubstArg(const Fdecl& arg)
 }
 
 /* obtain a suitable Fdecl for the name to substitute */
-bool Lineout::GetNameArg(const char* name, Fdecl* res) const
+bool Lineout::GetNameArg(const Ident* name, Fdecl* res) const
 {
     /* need to first look for labels, then for EQUs */
-    Symbol* s = labels->Lookup(name); /* could be a label */
-    if (!s) s = symtab->Lookup(name); /* could be an EQU decl */
+    Symbol* s;
+    if (ctx->values)
+        s = ctx->values->Lookup(name);
+    else {
+        s = ctx->labels->Lookup(name); /* could be a label */
+        if (!s) s = ctx->symtab->Lookup(name); /* could be an EQU decl */
+    }
     if (s) {
         *res = s->GetValue();
         return true;
@@ -126,16 +157,7 @@ bool Lineout::GetNameArg(const char* name, Fdecl* res) const
     if (!curdef) return false;
     const VField* vfs = curdef->GetVfs(curvfs);
     if (!vfs) return false;
-    
-    int base = vfs->GetBase();
-    if (base == 0) {
-        yyerror("Invalid substitution");
-        return false;
-    }
-    int val = strtol(name, 0, base); /* convert number */
-    res->Set(base, vfs->Size(), val);
-    res->FixSize();
-    return true;
+    return vfs->Untyped(name->text, res);
 }
 
 void Lineout::SkipArg()
@@ -144,146 +166,345 @@ void Lineout::SkipArg()
     DebugSubst(SUB_SKIPARG);
 }
 
-const char* Lineout::lineno(bool hex)
+/* substitute arg # n later, when the forward reference is resolved */
+bool Lineout::DeferArg(const Ident* name, const Fdecl& arg)
 {
-    static char lbuf[80];
-    sprintf(lbuf, hex ? "%04X " : "%06o ", address);
-    return lbuf;
+    if (!curdef) return false;
+    const VField* vfs = curdef->GetVfs(curvfs++);
+    DebugSubst(SUB_VFS);
+    if (!vfs) return false;
+    new Fixup(this, vfs, name, arg);
+    return true;
 }
 
-void Lineout::dump_map_line(FILE* fd, bool hex, bool linewrap)
+/* reserve a FF field of size arg.sz for a forward reference */
+bool Lineout::DeferField(const Ident* name, const Fdecl& arg, int off)
 {
-    fprintf(fd, "%s", lineno(hex));
-    for (int i=0; i < sz; i++) {
-        if (i>0) {
-            if (linewrap && (i % 64)==0) fprintf(fd, hex ? "\n     " : "\n       ");
-            else if ((i % 16)==0) fputc(' ', fd);
+    if ((off + arg.sz) > sz)
+        return false;
+    new Fixup(this, 0, name, arg, off);
+    return true;
+}
+
+/****************************************************************************/
+
+/* copy the lines, which are in address order */
+Words::Words(Lineout* first)
+    : n(0), sz(ctx->set->WordSize()), addr(0), index(0), span(0)
+{
+    nl = LIMBS(sz);
+    for (Lineout* lo = first; lo; lo = lo->Next())
+        n++;
+    planes = new Limb[3*nl*n];
+    addr = new int[n];
+    int i = 0;
+    for (Lineout* lo = first; lo; lo = lo->Next(), i++) {
+        memcpy(Planes(i), lo->line->val, 3*nl*sizeof(Limb));
+        addr[i] = lo->address;
+    }
+    if (n == 0) return;
+
+    /* sparse ORGs would make the index huge, Find searches addr then */
+    span = addr[n-1] - addr[0] + 1;
+    if (span > WORDS_SPARSE * n) return;
+    index = new int[span];
+    for (i=0; i<span; i++) index[i] = -1;
+    for (i=n-1; i>=0; i--) index[addr[i] - addr[0]] = i;
+}
+
+Words::~Words()
+{
+    delete[] planes;
+    delete[] addr;
+    delete[] index;
+}
+
+/* the first word at address, or -1 */
+int Words::Find(int address) const
+{
+    if (index) {
+        int k = address - addr[0];
+        return k >= 0 && k < span ? index[k] : -1;
+    }
+    int lo = 0, hi = n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (addr[mid] < address) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo < n && addr[lo] == address ? lo : -1;
+}
+
+/* text of a byte in the output formats */
+static struct ByteText
+{
+    char hex[256][2];
+    char oct[256][3];
+    ByteText() {
+        for (int i=0; i < 256; i++) {
+            hex[i][0] = "0123456789ABCDEF"[i >> 4];
+            hex[i][1] = "0123456789ABCDEF"[i & 15];
+            oct[i][0] = '0' + (i >> 6);
+            oct[i][1] = '0' + ((i >> 3) & 7);
+            oct[i][2] = '0' + (i & 7);
         }
-        fputc(UN_OVL(line[i]), fd);
     }
-    fputc('\n', fd);
+} bytes;
+
+/* the address as "%04X " or "%06o " */
+char* Words::lineno(char* p, int address, bool hex)
+{
+    char tmp[12];
+    unsigned a = address;
+    int n = 0;
+    do {
+        tmp[n++] = "0123456789ABCDEF"[hex ? a & 15 : a & 7];
+        a >>= hex ? 4 : 3;
+    } while (a);
+    while (n < (hex ? 4 : 6))
+        tmp[n++] = '0';
+    while (n)
+        *p++ = tmp[--n];
+    *p++ = ' ';
+    return p;
 }
 
-void Lineout::PrintMapLine(Printer* pr, bool hex)
+/* also the trace of a Lineout */
+void Words::MapLine(FILE* fd, int address, const Bitplanes* line, bool hex, bool linewrap)
 {
-    char lbuf[2];
-    
-    pr->Collect(lineno(hex));
-    for (int i=0; i < sz; i++) {
+    char buf[WORD_MAXLINE];
+    char* end = put_map(buf, address, line, (hex ? DM_HEX : 0) | (linewrap ? DM_WRAP : 0));
+    fwrite(buf, 1, end - buf, fd);
+}
+
+void Words::PrintMapLine(Printer* pr, int k, bool hex)
+{
+    Bitplanes line(sz, Planes(k));
+    char buf[WORD_MAXLINE];
+    char* end = put_map(buf, addr[k], &line, (hex ? DM_HEX : 0) | DM_WRAP) - 1;
+
+    /* no newline, and an undefined bit prints as nothing */
+    char* q = buf;
+    for (char* s = buf; s < end; s++)
+        if (*s) *q++ = *s;
+    pr->Collect(buf, q - buf);
+    pr->Flush();
+}
+
+char* Words::put_map(char* p, int address, const Bitplanes* line, int dmode)
+{
+    bool hex = dmode & DM_HEX;
+    p = lineno(p, address, hex);
+    int w = line->Size();
+    for (int i=0; i < w; i += 16) {
         if (i>0) {
-            if ((i % 64)==0) pr->Collect(hex ? "\n     " : "\n       ");
-            else if ((i % 16)==0) pr->Collect(" ");
+            if ((dmode & DM_WRAP) && (i % 64)==0) {
+                strcpy(p, hex ? "\n     " : "\n       ");
+                p += strlen(p);
+            } else
+                *p++ = ' ';
         }
-        lbuf[0] = UN_OVL(line[i]);
-        lbuf[1] = '\0';
-        pr->Collect(lbuf);
+        p = line->Text(p, i, w-i < 16 ? w-i : 16);
     }
-//    pr->Collect("\n");
-    pr->Flush();
+    *p++ = '\n';
+    return p;
 }
 
-void Lineout::dump_bpnf_line(FILE* fd, bool hex, int xreplace)
+char* Words::put_bpnf(char* p, int address, const Bitplanes* line, int dmode)
 {
-    fprintf(fd, "%s", lineno(hex));
-    fputc('B', fd);
-    for (int i=0; i < sz; i++) {
-        int bit = UN_OVL(line[i]);
-        switch (bit) {
-        case '0': bit = 'N'; break;
-        case '1': bit = 'P'; break;
-        case 'X': bit = xreplace; break;
+    p = lineno(p, address, dmode & DM_HEX);
+    *p++ = 'B';
+    char* s = p;
+    p = line->Text(p, 0, line->Size());
+    for (; s < p; s++) {
+        switch (*s) {
+        case '0': *s = 'N'; break;
+        case '1': *s = 'P'; break;
+        case 'X': *s = dmode & DM_REPL; break;
         default:
-            fprintf(stderr,"Invalid value %x found\n", bit);
-            internal_error(__FILE__, __LINE__);
+            return 0;
         }
-        fputc(bit, fd);
     }
-    fprintf(fd, "F\n");
+    *p++ = 'F';
+    *p++ = '\n';
+    return p;
 }
 
-void Lineout::dump_grouped_line(FILE* fd, bool hex)
+char* Words::put_grouped(char* p, int address, const Bitplanes* line, int dmode)
 {
-    fprintf(fd, "%s", lineno(hex));
-    columns->DumpLine(fd, line);
+    p = lineno(p, address, dmode & DM_HEX);
+    return ctx->columns->Text(p, line);
 }
 
-void Lineout::dump_byte(FILE* fd, int dmode, const char* lp, int n)
+char* Words::put_bytes(char* p, int address, const Bitplanes* line, int dmode)
 {
-    int num = 0;
-    for (int i=0; i<n; i++) {
-        int bit = UN_OVL(lp[i]);
-        if (bit == 'X') bit = dmode & DM_REPL;
-        num <<= 1;
-        if (bit == '1') num |= 1;
+    bool hex = dmode & DM_HEX;
+    bool repl1 = (dmode & DM_REPL) == DM_REPL1;
+    if (dmode & DM_ADDR) p = lineno(p, address, hex);
+
+    /* the leftmost byte has the odd bits */
+    int w = line->Size();
+    int n = w % 8 ? w % 8 : 8;
+    for (int i=0; i<w; i += n, n = 8) {
+        /* value bits, X bits as replaced */
+        int num = line->Get(i, n);
+        if (repl1) num |= line->GetX(i, n);
+        if (dmode & DM_SPACE) *p++ = ' ';
+        if (hex) {
+            memcpy(p, bytes.hex[num], 2);
+            p += 2;
+        } else {
+            memcpy(p, bytes.oct[num], 3);
+            p += 3;
+        }
     }
-    if (dmode & DM_SPACE) fputc(' ', fd);
-    fprintf(fd, (dmode & DM_HEX) ? "%02X" : "%03o", num);
+    *p++ = '\n';
+    return p;
 }
 
-void Lineout::dump_byte_line(FILE* fd, int dmode)
+/* (WORD+7)/8 bytes, the rightmost bits first */
+char* Words::put_raw(char* p, int address, const Bitplanes* line, int dmode)
 {
-    if (dmode & DM_ADDR) fprintf(fd, "%s", lineno(dmode & DM_HEX));
+    bool repl1 = (dmode & DM_REPL) == DM_REPL1;
+    for (int pos = line->Size(); pos > 0; pos -= 8) {
+        int n = pos < 8 ? pos : 8;
+        int num = line->Get(pos-n, n);
+        if (repl1) num |= line->GetX(pos-n, n);
+        *p++ = num;
+    }
+    return p;
+}
 
-    int w = set->WordSize();
-    int rest = w % 8;
-    if (rest)
-        dump_byte(fd, dmode, line, rest);
-    for (int i=rest; i<w; i += 8)
-        dump_byte(fd, dmode, line+i, 8);
-    fputc('\n', fd);
+char* Words::put_bin(char* p, int address, const Bitplanes* line, int dmode)
+{
+    char* s = p;
+    p = line->Text(p, 0, line->Size());
+    for (; s < p; s++)
+        if (*s == 'X') *s = dmode & DM_REPL;
+    *p++ = '\n';
+    return p;
 }
 
-void Lineout::dump_bin_line(FILE* fd, int dmode)
+const Writer Words::writers[] = {
+    { "bp",     put_bpnf,       DM_RADIX|'P' },
+    { "bn",     put_bpnf,       DM_RADIX|'N' },
+    { "h0",     put_bytes,      DM_ADDR|DM_SPACE|DM_HEX|DM_REPL0 },
+    { "h1",     put_bytes,      DM_ADDR|DM_SPACE|DM_HEX|DM_REPL1 },
+    { "q0",     put_bytes,      DM_ADDR|DM_SPACE|DM_REPL0 },
+    { "q1",     put_bytes,      DM_ADDR|DM_SPACE|DM_REPL1 },
+    { "r0",     put_raw,        DM_REPL0 },
+    { "r1",     put_raw,        DM_REPL1 },
+    { "m",      put_map,        DM_RADIX },
+    { "mg",     put_grouped,    DM_RADIX },
+    { "vb0",    put_bin,        DM_REPL0 },
+    { "vb1",    put_bin,        DM_REPL1 },
+    { "vh0",    put_bytes,      DM_HEX|DM_REPL0 },
+    { "vh1",    put_bytes,      DM_HEX|DM_REPL1 },
+    { 0 }
+};
+
+const Writer* Words::FindWriter(const char* name)
 {
-    int w = set->WordSize();
-    for (int i=0; i<w; i++) {
-        int bit = UN_OVL(line[i]);
-        if (bit == 'X') bit = dmode & DM_REPL;
-        fputc(bit, fd);
-    }
-    fputc('\n', fd);
+    for (const Writer* w = writers; w->name; w++)
+        if (!strcasecmp(name, w->name)) return w;
+    return 0;
 }
 
-void Lineout::DumpMap(FILE* fd)
+/* a writer returned 0 for the line: it has an undefined bit */
+void Words::Invalid(const Bitplanes* line)
 {
-    bool hex = set->HexMode();
-    for (Lineout* lo = First(); lo; lo = lo->Next())
-        lo->dump_map_line(fd, hex, false);
+    for (int i=0; i < line->Size(); i++) {
+        int bit = line->Bit(i);
+        if (bit != '0' && bit != '1' && bit != 'X') {
+            fprintf(stderr,"Invalid value %x found\n", bit);
+            break;
+        }
+    }
+    internal_error(__FILE__, __LINE__);
 }
 
-void Lineout::DumpBPNF(FILE* fd, int xreplace)
+/****************************************************************************/
+
+Fixup::Fixup(Lineout* l, const VField* v, const Ident* nam, const Fdecl& a, int off)
+    : next(ctx->froot), lo(l), vfs(v), offset(off), name(nam), arg(a)
 {
-    bool hex = set->HexMode();
-    for (Lineout* lo = First(); lo; lo = lo->Next())
-        lo->dump_bpnf_line(fd, hex, xreplace);
+    ctx->froot = this;
+    lineno = ctx->fwdline;
+    text = ctx->fwdtext;
+    ctx->fwdtext = 0;
 }
 
-void Lineout::DumpGrouped(FILE* fd)
+/* a name which is neither label nor EQU yet, may be defined later */
+bool Fixup::IsForward(const Ident* name)
 {
-    bool hex = set->HexMode();
-    for (Lineout* lo = First(); lo; lo = lo->Next())
-        lo->dump_grouped_line(fd, hex);
+    if (!ctx->set->SinglePass() || isdigit(name->text[0]) || ctx->labels->Lookup(name))
+        return false;
+    Symbol* s = ctx->symtab->Lookup(name);
+    return !s || s->IsA() != ISA_EQU;
 }
 
-void Lineout::DumpBytes(FILE* fd, int dmode)
+/* same resolution as Lineout::GetNameArg in phase 2b */
+bool Fixup::resolve()
 {
-    for (Lineout* lo = First(); lo; lo = lo->Next())
-        lo->dump_byte_line(fd, dmode);
+    Fdecl val;
+    Symbol* s = ctx->labels->Lookup(name);
+    if (!s) s = ctx->symtab->Lookup(name);
+    if (s)
+        val = s->GetValue();
+    else if (vfs) {
+        if (!vfs->Untyped(name->text, &val)) return false;
+    } else {
+        yyerror("Undeclared NAME");
+        return false;
+    }
+
+    /* reference was part of an expression */
+    if (arg.fmt & F_MASK)
+        val.Set(F_DEC, 0, val.value + arg.value);
+
+    if (vfs)
+        return vfs->Subst(lo->line, val);
+
+    val.sz = arg.sz;
+    return lo->SubstField(val, offset);
 }
 
-void Lineout::DumpBin(FILE* fd, int dmode)
+/* patch all forward references in source order */
+void Fixup::ResolveAll()
 {
-    for (Lineout* lo = First(); lo; lo = lo->Next())
-        lo->dump_bin_line(fd, dmode);
+    Fixup* nroot = 0;
+    for (Fixup* r = ctx->froot; r; ) {
+        Fixup* n = r->next;
+        r->next = nroot;
+        nroot = r;
+        r = n;
+    }
+
+    /* errors show line and column of the reference */
+    Printer* pr = ctx->p;
+    int lno = pr->Lineno();
+    char* line = copystr(pr->Linebuf());
+    ctx->froot = 0;
+    while (nroot) {
+        Fixup* fx = nroot;
+        nroot = fx->next;
+        pr->SetLineno(fx->lineno);
+        pr->SetLinebuf(fx->text);
+        fx->resolve();
+        delete fx;
+    }
+    pr->SetLineno(lno);
+    pr->SetLinebuf(line);
+    delete[] line;
 }
 
 void Lineout::DebugSubst(int flag)
 {
-    if (set->IsDebug(DBG_SUBST)) {
+    if (ctx->set->IsDebug(DBG_SUBST)) {
         switch (flag) {
         case SUB_CURMAP:
             fprintf(stderr, "--- Map line is now:\n");
-            dump_map_line(stderr, true);
+            Words::MapLine(stderr, address, line, true);
             fputc('\n', stderr);
             break;
         case SUB_NEWLINE:
@@ -24,63 +24,50 @@ protected:
     int col[128];
     int ncols;
     int sz;
+    friend class Cache;
 public:
     ColMap();
     ~ColMap() {}
     
     void AddColumn(int sz);
-    void DumpLine(FILE* fd, const char* map) const;
+    char* Text(char* p, const Bitplanes* line) const;
     int Size() const { return sz; }
 };
 
-extern ColMap* columns;
-
 
 class Lineout
 {
 protected:
     Lineout* next;
-    char* line;
+    Bitplanes* line;
     int sz;
     int address;
     Def* curdef;
     int curvfs;
     
-    static Lineout* root;
-    static bool revflag;
     static Lineout* reverse();
     
-    const char* lineno(bool hex);
-    void dump_map_line(FILE* fd, bool hex, bool linewrap=true);
-    void dump_bpnf_line(FILE* fd, bool hex, int xreplace);
-    void dump_grouped_line(FILE* fd, bool hex);
-
-/* dmode argument */
-#define DM_REPL     0x0ff
-#define DM_REPL1    '1'
-#define DM_REPL0    '0'
-#define DM_ADDR     0x100
-#define DM_HEX      0x200
-#define DM_SPACE    0x400
-    void dump_byte(FILE* fd, int dmode, const char* lp, int n);
-    void dump_byte_line(FILE* fd, int dmode);
-    void dump_bin_line(FILE* fd, int dmode);
+    friend class Fixup;
+    friend class Chunk;
+    friend class Words;
 public:
     Lineout();
-    ~Lineout();
+    void* operator new(size_t n);
+    void operator delete(void*) {}
     
     int LocPtr() const { return address; }
-    bool SetOverlayFormat(const char* name);
-    bool SubstField(const Field* arg);
+    bool SetOverlayFormat(const Ident* name);
+    bool SubstField(const Fdecl& val, int off);
+    bool SubstDC(const Fdecl& val, int off);
     bool SubstArg(const Fdecl& val);
-    bool GetNameArg(const char* name, Fdecl* res) const;
+    bool GetNameArg(const Ident* name, Fdecl* res) const;
     void SkipArg();
+    bool DeferArg(const Ident* name, const Fdecl& arg);
+    bool DeferField(const Ident* name, const Fdecl& arg, int off);
     
     static Lineout* First() { return reverse(); }
     Lineout* Next() const { return next; }
 
-    void PrintMapLine(Printer* p, bool hex);
-
 #define SUB_CURMAP 1
 #define SUB_NEWLINE 2
 #define SUB_SKIPARG 3
@@ -89,11 +76,97 @@ public:
 #define SUB_FIELD 6
     void DebugSubst(int flag);
 
-    static void DumpGrouped(FILE* fd);
-    static void DumpMap(FILE* fd);
-    static void DumpBPNF(FILE* fd, int dmode);
-    static void DumpBytes(FILE* fd, int dmode);
-    static void DumpBin(FILE* fd, int dmode);
+};
+
+/* formats one word in an output format (-o) at p, returns the end,
+ * or 0 if the format cannot show the word. Called by several threads */
+typedef char* (*WordWriter)(char* p, int address, const Bitplanes* line, int mode);
+
+/* room a writer needs for a line of a 128 bit word, with slack */
+#define WORD_MAXLINE 512
+
+/* dmode argument */
+#define DM_REPL     0x0ff
+#define DM_REPL1    '1'
+#define DM_REPL0    '0'
+#define DM_ADDR     0x100
+#define DM_HEX      0x200
+#define DM_SPACE    0x400
+#define DM_WRAP     0x800   /* map: new line after 64 bits */
+#define DM_RADIX    0x1000  /* address radix of -x, see Output::open */
+
+/* an output format: a new one only needs an entry in Words::writers */
+struct Writer
+{
+    const char* name;   /* as in -oname */
+    WordWriter put;
+    int mode;           /* passed to put */
+};
+
+/* The generated microwords in address order, packed into one array
+ * once phase 2b is done. The listing, the output formats and the library
+ * read them from here; the Lineouts are released. */
+/* largest span of addresses per word that gets a direct index */
+#define WORDS_SPARSE 4
+
+class Words
+{
+protected:
+    int n;
+    int sz;
+    int nl;             /* limbs per plane */
+    Limb* planes;       /* 3*nl limbs per word, see Bitplanes */
+    int* addr;          /* address of each word */
+    int* index;         /* word at address addr[0]+i, or -1; 0 if sparse */
+    int span;
+
+    static const Writer writers[];
+    static char* lineno(char* p, int address, bool hex);
+    static char* put_map(char* p, int address, const Bitplanes* line, int dmode);
+    static char* put_grouped(char* p, int address, const Bitplanes* line, int dmode);
+    static char* put_bpnf(char* p, int address, const Bitplanes* line, int dmode);
+    static char* put_bytes(char* p, int address, const Bitplanes* line, int dmode);
+    static char* put_bin(char* p, int address, const Bitplanes* line, int dmode);
+    static char* put_raw(char* p, int address, const Bitplanes* line, int dmode);
+public:
+    Words(Lineout* first);
+    ~Words();
+
+    int Count() const { return n; }
+    int Size() const { return sz; }
+    int Address(int i) const { return addr[i]; }
+    Limb* Planes(int i) const { return planes + 3*nl*i; }
+    int Find(int address) const;
+
+    static const Writer* FindWriter(const char* name);
+    static void Invalid(const Bitplanes* line);
+    static void MapLine(FILE* fd, int address, const Bitplanes* line, bool hex, bool linewrap=true);
+
+    void PrintMapLine(Printer* p, int k, bool hex);
+};
+
+/* forward reference of single pass mode, to be patched at END */
+class Fixup
+{
+protected:
+    Fixup* next;
+    Lineout* lo;
+    const VField* vfs;  /* VFS argument, or 0 for a FF field */
+    int offset;         /* offset of FF field */
+    const Ident* name;
+    Fdecl arg;          /* F_FWD value; base is set if part of an expression */
+    int lineno;
+    char* text;         /* the line up to the reference, for errors */
+    
+    bool resolve();
+public:
+    Fixup(Lineout* l, const VField* v, const Ident* nam, const Fdecl& a, int off=0);
+    ~Fixup() { delete[] text; }
+    
+    Fixup* Next() const { return next; }
+
+    static bool IsForward(const Ident* name);
+    static void ResolveAll();
 };
 
 #endif
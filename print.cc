@@ -1,10 +1,11 @@
 #include "amdasm.h"
+#include <pthread.h>
 
 Printer::Printer(const char* file, int ph)
     : outf(0), lpp(66), lcnt(66), lineno(1), errcnt(0), list(true), 
-      lno_mode(P_LNO_DEC), phase(ph)
+      lno_mode(P_LNO_DEC), phase(ph), rec(0), reclen(0), recmax(0)
 {
-    lpp = set->LinesPerPage();
+    lpp = ctx->set->LinesPerPage();
     title = 0;
 
     linebuf = new char[4096];
@@ -14,20 +15,74 @@ Printer::Printer(const char* file, int ph)
     clear_error();
     
     if (file) {
-        outf = fopen(file,"w");
+        outf = Server::Open(file, "w");
         verbose("*** Write phase %d listing to %s\n", phase, file);
     }
 }
 
+/* a printer for a phase 2b worker, which records the listing for
+ * the master to replay in order; nothing to record if master doesn't list */
+Printer::Printer(const Printer* master)
+    : outf(0), lpp(master->lpp), lcnt(66), lineno(1), errcnt(0), list(true),
+      lno_mode(P_LNO_DEC), phase(master->phase), title(0), rec(0), reclen(0), recmax(0)
+{
+    linebuf = new char[4096];
+    clear_line();
+
+    errorbuf = new char[4096];
+    clear_error();
+
+    if (master->outf) {
+        recmax = 65536;
+        rec = new char[recmax];
+    }
+}
+
 Printer::~Printer()
 {
     if (outf) {
         fprintf(outf, "\n\nTOTAL PHASE %d ERRORS = %4d\n", phase, errcnt);
         fclose(outf);
     }
-    delete title;
-    delete linebuf;
-    delete errorbuf;
+    delete[] title;
+    delete[] linebuf;
+    delete[] errorbuf;
+    delete[] rec;
+}
+
+/* append an event: a tag char followed by a NUL terminated argument */
+void Printer::record(int ev, const char* s)
+{
+    int n = strlen(s) + 2;
+    if (reclen + n > recmax) {
+        while (reclen + n > recmax) recmax *= 2;
+        char* nrec = new char[recmax];
+        memcpy(nrec, rec, reclen);
+        delete[] rec;
+        rec = nrec;
+    }
+    rec[reclen] = ev;
+    strcpy(rec + reclen + 1, s);
+    reclen += n;
+}
+
+/* pass the recorded listing to the master, and the unfinished line */
+void Printer::Replay(Printer* to) const
+{
+    for (int i = 0; i < reclen; i += strlen(rec + i + 1) + 2) {
+        const char* arg = rec + i + 1;
+        switch (rec[i]) {
+        case 'F':   to->Collect(arg); to->Flush(); break;
+        case 'T':   to->SetTitle(arg); break;
+        case 'L':   to->List(); break;
+        case 'N':   to->Nolist(); break;
+        case 'S':   to->Space(atoi(arg)); break;
+        case 'E':   to->Eject(); break;
+        default:    internal_error(__FILE__, __LINE__);
+        }
+    }
+    to->Collect(linebuf);
+    to->SetLineno(lineno);
 }
 
 void Printer::Emit(const char* fmt, ...)
@@ -62,6 +117,8 @@ void Printer::NewPage()
 
 void Printer::SetTitle(const char* ttl)
 {
+    if (rec) record('T', ttl);
+    delete[] title;
     title = copystr(ttl);
 }
 
@@ -77,6 +134,13 @@ void Printer::Collect(const char* s)
     strcat(linebuf, s);
 }
 
+void Printer::Collect(const char* s, int len)
+{
+    char* end = linebuf + strlen(linebuf);
+    memcpy(end, s, len);
+    end[len] = '\0';
+}
+
 void Printer::print_lineno()
 {
     switch (lno_mode) {
@@ -119,6 +183,12 @@ void Printer::print_errors()
 
 void Printer::Flush()
 {
+    if (rec) {
+        record('F', linebuf);
+        lineno++;
+        clear_line();
+        return;
+    }
     NewPage();
     print_lineno();
     Emit(linebuf); NewLine(1);
@@ -130,17 +200,27 @@ void Printer::Flush()
 
 void Printer::Space(int n)
 {
+    if (rec) {
+        char num[16];
+        sprintf(num, "%d", n);
+        record('S', num);
+        return;
+    }
     NewLine(n);
 }
 
 void Printer::Eject()
 {
+    if (rec) {
+        record('E');
+        return;
+    }
     NewLine(lpp - lcnt);
 }
 
 void Printer::PrintSymbols()
 {
-    bool hex = set->HexMode();
+    bool hex = ctx->set->HexMode();
 
     list = true;
     Eject();
@@ -151,89 +231,285 @@ void Printer::PrintSymbols()
 
     Emit("ENTRY POINTS\n");
     NewLine();
-    if (labels->PrintSymbols(this, true, hex))
+    if (ctx->labels->PrintSymbols(this, true, hex))
         NewLine();
 
     Emit("SYMBOLS\n");
     NewLine();
-    labels->PrintSymbols(this, false, hex);        
+    ctx->labels->PrintSymbols(this, false, hex);        
 }
 
 void Printer::PrintMap()
 {
-    bool hex = set->HexMode();
+    bool hex = ctx->set->HexMode();
     lno_mode = P_LNO_NO;
     list = true;
     Eject();
     NewPage();
-    for (Lineout* lo = Lineout::First(); lo; lo = lo->Next()) {
-        lo->PrintMapLine(this, hex);
-    }
+    Words* w = ctx->words;
+    for (int i=0; i < w->Count(); i++)
+        w->PrintMapLine(this, i, hex);
 }
 
 /****************************************************************************/
 
-Output* Output::oroot = 0;
-
 Output::Output(const char* fm, const char* fil)
+    : fd(0), writer(0), mode(0), buf(0), len(0), slice(0)
 {
     fmt = copystr(fm);
     file = copystr(fil);
-    next = oroot;
-    oroot = this;
+    next = ctx->oroot;
+    ctx->oroot = this;
 }
 
 Output::~Output()
 {
-    delete fmt;
-    delete file;
+    if (fd) fclose(fd);
+    delete[] buf;
+    delete[] fmt;
+    delete[] file;
 }
 
-/* generate the various output files */
-void Output::Dump()
+/* open the file for the writer of the format */
+bool Output::open()
 {
-    if (oroot==0) {
-        verbose("*** No -o option given: no output files produced\n");
+    fd = Server::Open(file, "wb");
+    if (fd == 0) {
+        verbose("*** Cannot open output file %s\n", file);
+        return false;
+    }
+    writer = Words::FindWriter(fmt);
+    if (writer == 0) {
+        verbose("*** Unknown output format %s, ignored\n", fmt);
+        fclose(fd);
+        fd = 0;
+        return false;
+    }
+    mode = writer->mode;
+    if ((mode & DM_RADIX) && ctx->set->HexMode())
+        mode |= DM_HEX;
+    buf = new char[OUT_BUFSIZE];
+    len = 0;
+    return true;
+}
+
+/* a range of words of one file, formatted by a worker thread */
+struct Slice
+{
+    Output* o;
+    int first, last;
+    char* buf;
+    int len;            /* -1 if a word cannot be written */
+};
+
+/* state shared by the worker threads */
+struct SlicePool
+{
+    pthread_mutex_t lock;
+    Slice* next;        /* next slice to format */
+    Slice* end;
+    Words* words;
+    Context* parent;
+};
+
+/* one pass over the words, each goes to all open files */
+void Output::write(Words* w)
+{
+    int jobs = ctx->set->Jobs();
+    if (jobs > 1 && w->Count() >= OUT_PARALLEL) {
+        parallel(w, jobs);
         return;
     }
+    for (int i=0; i < w->Count(); i++)
+        for (Output* o = ctx->oroot; o; o = o->next)
+            if (o->fd) o->put(w, i);
+}
 
-    for (Output* o = oroot; o; o = o->next) {
-        FILE* fd = fopen(o->file, "wb");
-        if (fd == 0) {
-            verbose("*** Cannot open output file %s\n", o->file);
-            continue;
+/* append word i to the buffer */
+void Output::put(Words* w, int i)
+{
+    if (len > OUT_BUFSIZE - WORD_MAXLINE) flush();
+    Bitplanes line(w->Size(), w->Planes(i));
+    char* end = writer->put(buf + len, w->Address(i), &line, mode);
+    if (end == 0) Words::Invalid(&line);
+    len = end - buf;
+}
+
+void* Output::worker(void* arg)
+{
+    SlicePool* pool = (SlicePool*)arg;
+    Words* w = pool->words;
+    ctx = pool->parent;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        Slice* s = pool->next < pool->end ? pool->next++ : 0;
+        pthread_mutex_unlock(&pool->lock);
+        if (s == 0) break;
+
+        char* p = s->buf;
+        for (int i = s->first; p && i < s->last; i++) {
+            Bitplanes line(w->Size(), w->Planes(i));
+            p = s->o->writer->put(p, w->Address(i), &line, s->o->mode);
         }
-        const char* fmt = o->fmt;
-        if (!strcasecmp(fmt, "bp"))
-            Lineout::DumpBPNF(fd, 'P');
-        else if (!strcasecmp(fmt, "bn"))
-            Lineout::DumpBPNF(fd, 'N');
-        else if (!strcasecmp(fmt, "h0"))
-            Lineout::DumpBytes(fd, DM_ADDR|DM_SPACE|DM_HEX|DM_REPL0);
-        else if (!strcasecmp(fmt, "h1")) {
-            Lineout::DumpBytes(fd, DM_ADDR|DM_SPACE|DM_HEX|DM_REPL1);
-        } else if (!strcasecmp(fmt, "q0")) {
-            Lineout::DumpBytes(fd, DM_ADDR|DM_SPACE|DM_REPL0);
-        } else if (!strcasecmp(fmt, "q1")) {
-            Lineout::DumpBytes(fd, DM_ADDR|DM_SPACE|DM_REPL1);
-        } else if (!strcasecmp(fmt, "m"))
-            Lineout::DumpMap(fd);
-        else if (!strcasecmp(fmt, "mg"))
-            Lineout::DumpGrouped(fd);
-        else if (!strcasecmp(fmt, "vb0")) {
-            Lineout::DumpBin(fd, DM_REPL0);
-        } else if (!strcasecmp(fmt, "vb1")) {
-            Lineout::DumpBin(fd, DM_REPL1);
-        } else if (!strcasecmp(fmt, "vh0")) {
-            Lineout::DumpBytes(fd, DM_HEX|DM_REPL0);
-        } else if (!strcasecmp(fmt, "vh1")) {
-            Lineout::DumpBytes(fd, DM_HEX|DM_REPL1);
-        } else {
-            verbose("*** Unknown output format %s, ignored\n", fmt);
-            fclose(fd);
-            continue;
+        s->len = p ? p - s->buf : -1;
+    }
+    ctx = 0;
+    return 0;
+}
+
+/* -j: the words are cut into slices for each file, which the threads
+ * format in rounds of OUT_ROUND per job. The lines of a format have the
+ * same length but for the address, so the first one tells how many fit
+ * into a slice. The slices are then written in order; one with a bad
+ * word is redone serially for the diagnostic. */
+void Output::parallel(Words* w, int jobs)
+{
+    Output* o;
+    int n = 0;
+    for (o = ctx->oroot; o; o = o->next) {
+        if (o->fd == 0) continue;
+        char tmp[WORD_MAXLINE];
+        Bitplanes line(w->Size(), w->Planes(0));
+        char* end = o->writer->put(tmp, w->Address(0), &line, o->mode);
+        if (end == 0) Words::Invalid(&line);
+
+        /* up to 8 more address digits */
+        o->slice = (OUT_SLICESIZE - WORD_MAXLINE) / (end - tmp + 8);
+        n += (w->Count() + o->slice - 1) / o->slice;
+    }
+
+    /* interleave the files, so that all are formatted at once */
+    Slice* slices = new Slice[n];
+    int k = 0;
+    for (int i = 0; k < n; i++)
+        for (o = ctx->oroot; o; o = o->next) {
+            if (o->fd == 0 || i*o->slice >= w->Count()) continue;
+            Slice* s = &slices[k++];
+            s->o = o;
+            s->first = i*o->slice;
+            s->last = s->first + o->slice;
+            if (s->last > w->Count()) s->last = w->Count();
         }
-        verbose("*** Write output format -o%s to %s\n", fmt, o->file);
-        fclose(fd);
+
+    int round = jobs * OUT_ROUND;
+    char** bufs = new char*[round];
+    for (int i=0; i<round; i++)
+        bufs[i] = new char[OUT_SLICESIZE];
+    pthread_t* tids = new pthread_t[jobs];
+
+    SlicePool pool;
+    pthread_mutex_init(&pool.lock, 0);
+    pool.words = w;
+    pool.parent = ctx;
+    for (int r = 0; r < n; r += round) {
+        int m = n - r < round ? n - r : round;
+        for (int i=0; i<m; i++)
+            slices[r+i].buf = bufs[i];
+        pool.next = slices + r;
+        pool.end = slices + r + m;
+        int t = jobs < m ? jobs : m;
+        for (int i=0; i<t; i++)
+            if (pthread_create(&tids[i], 0, worker, &pool))
+                internal_error(__FILE__, __LINE__);
+        for (int i=0; i<t; i++)
+            pthread_join(tids[i], 0);
+
+        for (int i=0; i<m; i++) {
+            Slice* s = &slices[r+i];
+            if (s->len < 0) {
+                for (int j = s->first; j < s->last; j++)
+                    s->o->put(w, j);
+                continue;
+            }
+            s->o->flush();
+            fwrite(s->buf, 1, s->len, s->o->fd);
+        }
+    }
+    pthread_mutex_destroy(&pool.lock);
+    delete[] tids;
+    for (int i=0; i<round; i++)
+        delete[] bufs[i];
+    delete[] bufs;
+    delete[] slices;
+}
+
+void Output::flush()
+{
+    fwrite(buf, 1, len, fd);
+    len = 0;
+}
+
+void Output::close()
+{
+    flush();
+    verbose("*** Write output format -o%s to %s\n", fmt, file);
+    fclose(fd);
+    fd = 0;
+    delete[] buf;
+    buf = 0;
+}
+
+/* -w: only if no one else needs all words at the end: the map of the
+ * phase 2 listing, the library result, or a server request */
+bool Output::Streaming(Context* cx)
+{
+    Settings* s = cx->set;
+    return s->Stream() && cx->oroot && !cx->lib && !cx->spool && !s->P2File();
+}
+
+/* open the files; with -w before phase 2b assembles. Formerly each
+ * file was written in turn, so of several formats for the same file
+ * the last one in the list is left; only that one is written */
+void Output::Open()
+{
+    for (Output* o = ctx->oroot; o; o = o->next) {
+        Output* later;
+        for (later = o->next; later; later = later->next)
+            if (!strcmp(o->file, later->file)) break;
+        if (later)
+            verbose("*** Output format -o%s to %s replaced by -o%s\n", o->fmt, o->file, later->fmt);
+        else
+            o->open();
+    }
+}
+
+/* after a statement of phase 2b: with -w, pass a full window of lines
+ * to the writers, unless one still waits for a forward reference */
+void Output::Stream()
+{
+    if (!ctx->streaming || ++ctx->nstream < STREAM_WINDOW || ctx->froot) return;
+
+    Words w(Lineout::First());
+    write(&w);
+    ctx->lroot = 0;
+    ctx->lrevflag = false;
+    ctx->arena->Release();
+    ctx->nstream = 0;
+}
+
+/* generate the various output files, or with -w their last window */
+void Output::Dump()
+{
+    if (ctx->oroot==0) {
+        verbose("*** No -o option given: no output files produced\n");
+        return;
+    }
+
+    if (!ctx->streaming) Open();
+    write(ctx->words);
+    for (Output* o = ctx->oroot; o; o = o->next)
+        if (o->fd) o->close();
+}
+
+/* phase 2b or a writer failed: don't leave partial output files */
+void Output::Abort()
+{
+    for (Output* o = ctx->oroot; o; o = o->next) {
+        if (o->fd == 0) continue;
+        fclose(o->fd);
+        o->fd = 0;
+        unlink(o->file);
+        delete[] o->buf;
+        o->buf = 0;
     }
 }
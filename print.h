@@ -36,7 +36,10 @@ private:
     char* title;
     char* linebuf;
     char* errorbuf;
+    char* rec;      /* listing recorded by a phase 2b worker */
+    int reclen, recmax;
     
+    void record(int ev, const char* s = "");
     void print_lineno();
     void print_errors();
     void count_nl(const char* buf);
@@ -45,6 +48,7 @@ private:
     
 public:
     Printer(const char* file, int ph);
+    Printer(const Printer* master);
     ~Printer();
     
     void SetTitle(const char* title);
@@ -52,8 +56,10 @@ public:
 
     void AddError(const char* s);
     const char* Linebuf() const { return linebuf; }
+    void SetLinebuf(const char* s) { strcpy(linebuf, s); }
     
     void Collect(const char* s);
+    void Collect(const char* s, int len);
     void Flush();
     void Emit(const char* fmt, ...);    
     void NewLine(int n = 1);
@@ -63,31 +69,58 @@ public:
     void Space(int n);
 
     int Errors() const { return errcnt; }
-    void List() { list = true; }
-    void Nolist() { list = false; }
+    void List() { if (rec) record('L'); list = true; }
+    void Nolist() { if (rec) record('N'); list = false; }
     int Lineno() const { return lineno; }
     void SetLineno(int lno) { lineno = lno; }
+    void Replay(Printer* to) const;
     
     void PrintSymbols();
     void PrintMap();
 };
 
-extern Printer* p;
-
 /* List of outputs to generate */
+/*forward*/ class Words;
+/*forward*/ struct Writer;
+/*forward*/ class Context;
+
+/* an output file (-o). Written at the end of phase 2b, or while
+ * assembling with -w, a window of STREAM_WINDOW words at a time */
+#define STREAM_WINDOW 1024
+#define OUT_BUFSIZE 65536   /* lines are collected, then written at once */
+#define OUT_PARALLEL 8192   /* -j: fewer words are written serially */
+#define OUT_SLICESIZE 262144 /* -j: text of the words formatted by one thread */
+#define OUT_ROUND 4         /* -j: slices per job at once, see Output::parallel */
 class Output
 {
     struct Output* next;
     char* fmt;
     char* file;
-    
-    static Output* oroot;
+    FILE* fd;
+    const Writer* writer;
+    int mode;           /* of the writer, resolved */
+    char* buf;          /* the lines to write */
+    int len;
+    int slice;          /* -j: words per slice */
 
+    bool open();
+    void put(Words* w, int i);
+    void flush();
+    void close();
+    static void write(Words* w);
+    static void parallel(Words* w, int jobs);
+    static void* worker(void* arg);
 public:
     Output(const char* fm, const char* fil);
     ~Output();
+
+    Output* Next() const { return next; }
     
+    static bool Streaming(Context* cx);
+    static void Open();
+    static void Stream();
     static void Dump();
+    static void Abort();
 };
 
 #endif
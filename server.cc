@@ -0,0 +1,511 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "amdasm.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <poll.h>
+
+#define SERVER_PROTOCOL 1
+#define SERVER_MAXARGS  1024
+
+/* phase 1 result of a DEF file, kept by the server */
+struct Resident
+{
+    Resident* next;
+    unsigned long long hash;
+    Context* def;
+};
+
+/* a handler tells the server of a new DEF file, which it left in
+ * its spool directory with the phase 1 result */
+struct Newdef
+{
+    char spool[32];
+    char name[256];     /* for -v only */
+};
+
+/****************************************************************************/
+
+/* messages are ints and byte strings with a length in front;
+ * both ends run on the same machine */
+static bool put(int fd, const void* buf, int len)
+{
+    const char* p = (const char*)buf;
+    while (len > 0) {
+        int n = write(fd, p, len);
+        if (n <= 0) return false;
+        p += n; len -= n;
+    }
+    return true;
+}
+
+static bool put_int(int fd, int v)
+{
+    return put(fd, &v, sizeof(int));
+}
+
+/* len -1 sends a missing file */
+static bool put_data(int fd, const char* buf, int len)
+{
+    return put_int(fd, len) && (len <= 0 || put(fd, buf, len));
+}
+
+static bool get(int fd, void* buf, int len)
+{
+    char* p = (char*)buf;
+    while (len > 0) {
+        int n = read(fd, p, len);
+        if (n <= 0) return false;
+        p += n; len -= n;
+    }
+    return true;
+}
+
+static bool get_int(int fd, int* v)
+{
+    return get(fd, v, sizeof(int));
+}
+
+/* returns a NUL terminated buffer, or 0 for a missing file */
+static bool get_data(int fd, char** buf, int* len)
+{
+    *buf = 0;
+    if (!get_int(fd, len) || *len < -1 || *len > 0x40000000) return false;
+    if (*len < 0) return true;
+    *buf = new char[*len+1];
+    (*buf)[*len] = '\0';
+    return get(fd, *buf, *len);
+}
+
+static char* slurp(const char* file, int* len)
+{
+    *len = -1;
+    FILE* fd = fopen(file, "rb");
+    if (fd == 0) return 0;
+    fseek(fd, 0, SEEK_END);
+    *len = ftell(fd);
+    fseek(fd, 0, SEEK_SET);
+    char* buf = new char[*len+1];
+    *len = fread(buf, 1, *len, fd);
+    fclose(fd);
+    return buf;
+}
+
+static int open_socket(const char* name, struct sockaddr_un* addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(name) >= sizeof(addr->sun_path)) return -1;
+    strcpy(addr->sun_path, name);
+    return socket(AF_UNIX, SOCK_STREAM, 0);
+}
+
+/****************************************************************************/
+
+Server::Server(int conn, int nfd)
+    : fd(conn), note(nfd), argc(0), argv(0), defname(0), defbuf(0), deflen(-1),
+      srcname(0), srcbuf(0), srclen(-1), spool(0)
+{}
+
+Server::~Server()
+{
+    for (int i=0; i<argc; i++)
+        delete[] argv[i];
+    delete[] argv;
+    delete[] defname;
+    delete[] defbuf;
+    delete[] srcname;
+    delete[] srcbuf;
+    delete[] spool;
+    close(fd);
+}
+
+bool Server::receive()
+{
+    int proto, n, len;
+    if (!get_int(fd, &proto) || proto != SERVER_PROTOCOL ||
+        !get_int(fd, &n) || n < 1 || n > SERVER_MAXARGS) return false;
+
+    argv = new char*[n+1];
+    for (argc=0; argc<n; argc++)
+        if (!get_data(fd, &argv[argc], &len) || argv[argc] == 0) return false;
+    argv[argc] = 0;
+
+    return get_data(fd, &defname, &len) && defname &&
+           get_data(fd, &defbuf, &deflen) &&
+           get_data(fd, &srcname, &len) && srcname &&
+           get_data(fd, &srcbuf, &srclen);
+}
+
+char* Server::path(const char* file) const
+{
+    char* p = new char[strlen(spool) + strlen(file) + 2];
+    sprintf(p, "%s/%s", spool, file);
+    return p;
+}
+
+/* in a process per connection: read the request, so that a slow
+ * client holds up no one else, and look up its DEF file by contents */
+Context* Server::handle(Resident* residents)
+{
+    char tmpl[] = "/tmp/amdasmXXXXXX";
+    if (!receive() || mkdtemp(tmpl) == 0) return 0;
+    spool = copystr(tmpl);
+
+    Resident* res = 0;
+    if (deflen >= 0) {
+        unsigned long long hash = Cache::Hash(Input::Open(defname, defbuf, deflen));
+        for (res = residents; res && res->hash != hash; res = res->next)
+            ;
+    }
+    return run(res);
+}
+
+/* assemble in a child, which may exit anywhere, then send what it
+ * left in the spool directory */
+Context* Server::run(Resident* res)
+{
+    pid_t pid = fork();
+    if (pid == 0) return assemble(res);
+
+    int st, status = 99;
+    if (pid > 0 && waitpid(pid, &st, 0) == pid && WIFEXITED(st))
+        status = WEXITSTATUS(st);
+    if (res == 0 && deflen >= 0) notify();
+    reply(status);
+    return 0;
+}
+
+/* first use of the DEF file: pass it and its phase 1 result on */
+void Server::notify()
+{
+    char* cache = path("def.cache");
+    bool ok = access(cache, R_OK) == 0;
+    delete[] cache;
+    char* def = path("in.def");
+    FILE* out = ok ? fopen(def, "wb") : 0;
+    delete[] def;
+    if (out == 0) return;
+    fwrite(defbuf, 1, deflen, out);
+    fclose(out);
+
+    /* less than PIPE_BUF: not mixed with those of other handlers */
+    Newdef nd;
+    memset(&nd, 0, sizeof(nd));
+    strncpy(nd.spool, spool, sizeof(nd.spool)-1);
+    strncpy(nd.name, defname, sizeof(nd.name)-1);
+    put(note, &nd, sizeof(nd));
+}
+
+/* in the server: keep the phase 1 result a handler passed on, with
+ * its DEFs prepared once for all later requests */
+static Resident* load(int note, Resident* residents)
+{
+    Newdef nd;
+    if (!get(note, &nd, sizeof(nd))) return residents;
+    nd.spool[sizeof(nd.spool)-1] = nd.name[sizeof(nd.name)-1] = '\0';
+    char def[sizeof(nd.spool) + 16], cache[sizeof(nd.spool) + 16];
+    sprintf(def, "%s/in.def", nd.spool);
+    sprintf(cache, "%s/def.cache", nd.spool);
+
+    Context* cur = ctx;
+    Context* cx = ctx = new Context();
+    cx->set->SetDefFile(def);
+    cx->set->SetCacheFile(cache);
+    Input* in = Input::Open(cx->set->DefFile());
+    Resident* res = 0;
+    if (in) {
+        unsigned long long hash = Cache::Hash(in);
+        for (res = residents; res && res->hash != hash; res = res->next)
+            ;
+        if (res == 0 && Cache::Load(cx)) {
+            for (Symbol* s = cx->symtab->First(); s; s = s->Next())
+                if (s->IsDef()) ((Def*)s)->Prepare();
+            res = new Resident;
+            res->next = residents;
+            res->hash = hash;
+            res->def = cx;
+            residents = res;
+            cx = 0;
+            ctx = cur;
+            verbose("*** Resident %s\n", nd.name);
+        }
+    }
+    delete cx;
+    ctx = cur;
+    unlink(def);
+    unlink(cache);
+    rmdir(nd.spool);
+    return residents;
+}
+
+/* in the assembling process: redirect console output to the spool
+ * and set up the context as if amdasm had been started by the client */
+Context* Server::assemble(Resident* res)
+{
+    char* out = path("stdout");
+    char* err = path("stderr");
+    int fd1 = open(out, O_WRONLY|O_CREAT|O_TRUNC, 0600);
+    int fd2 = open(err, O_WRONLY|O_CREAT|O_TRUNC, 0600);
+    if (fd1 < 0 || fd2 < 0) exit(99);
+    dup2(fd1, 1); close(fd1);
+    dup2(fd2, 2); close(fd2);
+    delete[] out;
+    delete[] err;
+
+    optind = 1;
+    Context* cx = parse_options(argc, argv);
+    cx->spool = spool;
+
+    /* a file the client could not read is missing, never the server's own */
+    if (deflen < 0 || srclen < 0) {
+        fprintf(stderr,"*** File %s does not exist\n", deflen < 0 ? defname : srcname);
+        fatal(1);
+    }
+    Input::Open(defname, defbuf, deflen);
+    Input::Open(srcname, srcbuf, srclen);
+
+    if (res) {
+        Context* def = res->def;
+        delete cx->symtab;
+        delete cx->labels;
+        delete cx->idents;
+        delete cx->columns;
+        cx->idents = def->idents;
+        cx->labels = new Symtab(cx->idents);
+        cx->symtab = def->symtab;
+        cx->columns = def->columns;
+        cx->set->SetWordSize(def->set->WordSize());
+        cx->defdone = true;
+        verbose("*** Using resident %s (Phase 1 skipped)\n", defname);
+    } else {
+        /* new DEF file: the server loads it from here */
+        char* cache = path("def.cache");
+        cx->set->SetCacheFile(cache);
+        delete[] cache;
+    }
+    return cx;
+}
+
+void Server::reply(int status)
+{
+    int len, n = 0;
+    char* buf;
+    char* file;
+    bool ok = put_int(fd, status);
+
+    file = path("stdout");
+    buf = slurp(file, &len);
+    ok = ok && put_data(fd, buf, len);
+    unlink(file);
+    delete[] file;
+    delete[] buf;
+
+    file = path("stderr");
+    buf = slurp(file, &len);
+    ok = ok && put_data(fd, buf, len);
+    unlink(file);
+    delete[] file;
+    delete[] buf;
+
+    /* the names of the output files, each ends with a NUL; the
+     * file itself is named by its number */
+    char* names = path("names");
+    char* list = slurp(names, &len);
+    for (int i=0; i<len; i++)
+        if (list[i] == '\0') n++;
+    ok = ok && put_int(fd, n);
+
+    char* name = list;
+    for (int i=0; i<n; i++) {
+        int nlen = strlen(name);
+        char num[16];
+        sprintf(num, "%d", i);
+        file = path(num);
+        buf = slurp(file, &len);
+        ok = ok && put_data(fd, name, nlen) && put_data(fd, buf, len);
+        unlink(file);
+        delete[] file;
+        delete[] buf;
+        name += nlen + 1;
+    }
+    unlink(names);
+    delete[] names;
+    delete[] list;
+
+    /* fails if the server still has to read the DEF */
+    rmdir(spool);
+}
+
+/* accept requests forever; returns only in a process
+ * that has to assemble a request */
+Context* Server::Serve(Context* cx)
+{
+    const char* name = cx->set->SockFile();
+    struct sockaddr_un addr;
+    int ls = open_socket(name, &addr);
+    unlink(name);
+    if (ls < 0 || bind(ls, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+        listen(ls, 16) < 0) {
+        fprintf(stderr, "*** Cannot listen on socket %s\n", name);
+        exit(1);
+    }
+    int note[2];
+    if (pipe(note) < 0) {
+        fprintf(stderr, "*** Cannot create pipe\n");
+        exit(1);
+    }
+    signal(SIGPIPE, SIG_IGN);
+    verbose("*** Serving on %s\n", name);
+
+    /* a handler process per connection; the server only accepts and
+     * keeps the DEF files handlers pass on */
+    Resident* residents = 0;
+    for (;;) {
+        while (waitpid(-1, 0, WNOHANG) > 0)
+            ;
+        struct pollfd pfd[2];
+        pfd[0].fd = ls;
+        pfd[1].fd = note[0];
+        pfd[0].events = pfd[1].events = POLLIN;
+        if (poll(pfd, 2, -1) < 0) continue;
+        if (pfd[1].revents & POLLIN)
+            residents = load(note[0], residents);
+        if (!(pfd[0].revents & POLLIN)) continue;
+
+        int conn = accept(ls, 0, 0);
+        if (conn < 0) continue;
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(ls);
+            close(note[0]);
+            Server* req = new Server(conn, note[1]);
+            Context* work = req->handle(residents);
+            if (work) return work;
+            _exit(0);
+        }
+        close(conn);
+    }
+}
+
+/* send arguments and input files to a server and write what it returns;
+ * returns false if there is no server to do that */
+bool Server::Request(Context* cx, int argc, char* argv[], int* status)
+{
+    const char* name = cx->set->SockFile();
+    struct sockaddr_un addr;
+    int fd = open_socket(name, &addr);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        verbose("*** No server on %s, assembling locally\n", name);
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    bool ok = put_int(fd, SERVER_PROTOCOL) && put_int(fd, argc);
+    for (int i=0; i<argc; i++)
+        ok = ok && put_data(fd, argv[i], strlen(argv[i]));
+    const char* file = cx->set->DefFile();
+    Input* in = Input::Open(file);
+    ok = ok && put_data(fd, file, strlen(file)) &&
+         put_data(fd, in ? in->Buffer() : 0, in ? in->Size() : -1);
+    file = cx->set->SrcFile();
+    in = Input::Open(file);
+    ok = ok && put_data(fd, file, strlen(file)) &&
+         put_data(fd, in ? in->Buffer() : 0, in ? in->Size() : -1);
+
+    if (!ok || !get_int(fd, status)) {
+        verbose("*** Server on %s failed, assembling locally\n", name);
+        close(fd);
+        return false;
+    }
+
+    int len, n = 0;
+    char* buf;
+    ok = get_data(fd, &buf, &len);
+    if (buf) fwrite(buf, 1, len, stdout);
+    delete[] buf;
+    ok = ok && get_data(fd, &buf, &len);
+    if (buf) fwrite(buf, 1, len, stderr);
+    delete[] buf;
+
+    ok = ok && get_int(fd, &n);
+    for (int i=0; ok && i<n; i++) {
+        char* fname;
+        ok = get_data(fd, &fname, &len) && fname && get_data(fd, &buf, &len);
+        if (ok) {
+            FILE* out = fopen(fname, "wb");
+            if (out) {
+                if (buf) fwrite(buf, 1, len, out);
+                fclose(out);
+            } else
+                fprintf(stderr, "*** Cannot write %s\n", fname);
+        }
+        delete[] fname;
+        delete[] buf;
+    }
+    close(fd);
+    if (!ok) {
+        fprintf(stderr, "*** Lost connection to server on %s\n", name);
+        *status = 1;
+    }
+    return true;
+}
+
+/* open an output file; a request writes it to its spool directory */
+FILE* Server::Open(const char* name, const char* mode)
+{
+    if (ctx->spool == 0) return fopen(name, mode);
+
+    char* p = new char[strlen(ctx->spool) + 16];
+    sprintf(p, "%s/names", ctx->spool);
+    FILE* fd = fopen(p, "ab");
+    if (fd) {
+        fwrite(name, 1, strlen(name)+1, fd);
+        fclose(fd);
+    }
+    sprintf(p, "%s/%d", ctx->spool, ctx->nspool++);
+    fd = fopen(p, mode);
+    delete[] p;
+    return fd;
+}
+
+#else
+/* no Unix domain sockets */
+Context* Server::Serve(Context* cx)
+{
+    fprintf(stderr, "*** Server mode is not supported\n");
+    exit(1);
+    return cx;
+}
+
+bool Server::Request(Context* cx, int argc, char* argv[], int* status)
+{
+    return false;
+}
+
+FILE* Server::Open(const char* name, const char* mode)
+{
+    return fopen(name, mode);
+}
+#endif
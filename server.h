@@ -0,0 +1,60 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef __SERVER_H__
+#define __SERVER_H__
+
+struct Resident;
+
+/* Server mode (-L): a resident process keeps the phase 1 result of every
+ * DEF file it has seen. A client (-R) sends its arguments with the DEF
+ * and SRC files. A process forked per connection reads them and assembles
+ * in a child of its own, so a request starts with phase 2a and cannot harm
+ * the server, and sends back the console output, the exit code and all
+ * files that were written. A DEF file seen for the first time is passed
+ * back to the server after phase 1, see notify. */
+class Server
+{
+protected:
+    int fd;                 /* connection to client */
+    int note;               /* pipe to the server, see notify */
+    int argc;
+    char** argv;
+    char* defname;
+    char* defbuf;
+    int deflen;             /* -1 if client has no such file */
+    char* srcname;
+    char* srcbuf;
+    int srclen;
+    char* spool;            /* directory for output files */
+
+    Server(int conn, int nfd);
+    ~Server();
+    bool receive();
+    char* path(const char* file) const;
+    Context* handle(Resident* residents);
+    Context* run(Resident* res);
+    void notify();
+    Context* assemble(Resident* res);
+    void reply(int status);
+public:
+    static Context* Serve(Context* cx);
+    static bool Request(Context* cx, int argc, char* argv[], int* status);
+    static FILE* Open(const char* name, const char* mode);
+};
+
+#endif
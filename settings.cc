@@ -17,44 +17,63 @@
 */
 #include "amdasm.h"
 
-Settings* Settings::_instance = 0;
-Settings* Settings::Instance()
-{
-    if (!_instance)
-        _instance = new Settings();
-    return _instance;
-}
-
 Settings::Settings()
-    : wordsize(0), nolist(false),
-      lpp(66), debug(0), hex(true), locptr(0), phase(0)
+    : wordsize(0), nolist(false), singlepass(false), stream(false), jobs(1),
+      lpp(66), debug(0), hex(true), serve(false), locptr(0), phase(0)
 {
-    yydebug = 0;
-    yy_flex_debug = 0;
-    
-    
     deffile =
     srcfile = 
     p1file =
     p2file =
+    cachefile =
+    sockfile =
+    batchfile =
     curfile = 0;
     prefix = copystr("amdout");
+    dflt[0] = dflt[1] = dflt[2] = dflt[3] = 0;
+}
+
+static char* dupstr(const char* s)
+{
+    return s ? copystr(s) : 0;
+}
+
+Settings::Settings(const Settings& org)
+    : wordsize(org.wordsize), nolist(org.nolist), singlepass(org.singlepass),
+      stream(org.stream), jobs(org.jobs), lpp(org.lpp), debug(org.debug), hex(org.hex),
+      serve(org.serve), locptr(org.locptr), phase(org.phase)
+{
+    deffile = dupstr(org.deffile);
+    srcfile = dupstr(org.srcfile);
+    p1file = dupstr(org.p1file);
+    p2file = dupstr(org.p2file);
+    prefix = dupstr(org.prefix);
+    cachefile = dupstr(org.cachefile);
+    sockfile = dupstr(org.sockfile);
+    batchfile = dupstr(org.batchfile);
+    curfile = dupstr(org.curfile);
+    dflt[0] = dflt[1] = dflt[2] = dflt[3] = 0;
 }
 
 Settings::~Settings()
 {
-    delete deffile;
-    delete srcfile;
-    delete p1file;
-    delete p2file;
-    delete prefix;
+    delete[] deffile;
+    delete[] srcfile;
+    delete[] p1file;
+    delete[] p2file;
+    delete[] prefix;
+    delete[] cachefile;
+    delete[] sockfile;
+    delete[] batchfile;
+    delete[] curfile;
+    clear_dflt();
 }
 
 int Settings::WordSize() const
 {
     if (wordsize <= 0) {
         yyerror("WORD size not declared. Can't continue");
-        exit(1);
+        fatal(1);
     }
     return wordsize;
 }
@@ -65,7 +84,7 @@ void Settings::SetWordSize(int w)
         yyerror("Multiple setting of WORD size");
     else if (w < 1 or w > 128) {
         yyerror("Invalid WORD size. Can't continue");
-        exit(1);
+        fatal(1);
     } else
         wordsize = w;
 }
@@ -74,7 +93,6 @@ void Settings::SetDebug(int flags)
 {
     debug = flags;
     yydebug = (debug & DBG_YACC) ? 1 : 0;
-    yy_flex_debug = (debug & DBG_LEX) ? 1 : 0;
 }
 
 int Settings::LocPtr() const
@@ -119,9 +137,24 @@ char* Settings::build_file(const char *prefix, const char* ext)
     return name;
 }
 
+const char* Settings::dflt_file(int i, const char* ext)
+{
+    if (!dflt[i]) dflt[i] = build_file(prefix, ext);
+    return dflt[i];
+}
+
+void Settings::clear_dflt()
+{
+    for (int i=0; i<4; i++) {
+        delete[] dflt[i];
+        dflt[i] = 0;
+    }
+}
+
 void Settings::SetPrefix(const char* pfx)
 {
-    delete prefix;
+    clear_dflt();
+    delete[] prefix;
     prefix = copystr(pfx);
     char* dot = strchr(prefix, '.');
     if (dot) *dot = '\0';
@@ -129,53 +162,72 @@ void Settings::SetPrefix(const char* pfx)
 
 const char* Settings::DefFile()
 {
-    return deffile ? deffile : build_file(prefix, ".def");
+    return deffile ? deffile : dflt_file(0, ".def");
 }
 
 void Settings::SetDefFile(const char* name)
 {
-    delete deffile;
+    delete[] deffile;
     deffile = build_file(name, ".def");
 }
 
 const char* Settings::SrcFile()
 {
-    return srcfile ? srcfile : build_file(prefix, ".src");
+    return srcfile ? srcfile : dflt_file(1, ".src");
 }
 
 void Settings::SetSrcFile(const char* name)
 {
-    delete srcfile;
+    delete[] srcfile;
     srcfile = build_file(name, ".src");
 }
 
 const char* Settings::P1File()
 {
     return p1file ? p1file : 
-           (nolist ? 0 : build_file(prefix, ".p1l"));
+           (nolist ? 0 : dflt_file(2, ".p1l"));
 }
 
 void Settings::SetP1File(const char* name)
 {
-    delete p1file;
+    delete[] p1file;
     p1file = build_file(name, ".p1l");
 }
 
 const char* Settings::P2File()
 {
     return p2file ? p2file : 
-           (nolist ? 0 : build_file(prefix, ".p2l"));
+           (nolist ? 0 : dflt_file(3, ".p2l"));
 }
 
 void Settings::SetP2File(const char* name)
 {
-    delete p2file;
+    delete[] p2file;
     p2file = build_file(name, ".p2l");
 }
 
+void Settings::SetCacheFile(const char* name)
+{
+    delete[] cachefile;
+    cachefile = copystr(name);
+}
+
+void Settings::SetSockFile(const char* name, bool srv)
+{
+    delete[] sockfile;
+    sockfile = copystr(name);
+    serve = srv;
+}
+
+void Settings::SetBatchFile(const char* name)
+{
+    delete[] batchfile;
+    batchfile = copystr(name);
+}
+
 void Settings::SetCurFile(const char* fname)
 {
-    delete curfile;
+    delete[] curfile;
     curfile = copystr(fname);
 }
 
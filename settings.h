@@ -24,10 +24,14 @@ private:
     int wordsize;
     
     bool nolist;
+    bool singlepass;
+    bool stream;
+    int jobs;
     int lpp;
     
     int debug;
     bool hex;
+    bool serve;
     
     int locptr;
     int phase;
@@ -37,15 +41,22 @@ private:
     char* p1file;
     char* p2file;
     char* prefix;
+    char* cachefile;
+    char* sockfile;
+    char* batchfile;
     
     char* curfile;
 
+    /* names derived from prefix, built on first use */
+    char* dflt[4];
+
     char* build_file(const char* pfx, const char* ext);
+    const char* dflt_file(int i, const char* ext);
+    void clear_dflt();
 
-    static Settings* _instance;
-    Settings();
 public:
-    static Settings* Instance();
+    Settings();
+    Settings(const Settings& org);
     ~Settings();
 
     int WordSize() const;
@@ -66,6 +77,15 @@ public:
     bool NoList() const { return nolist; }
     void SetNoList(bool n) { nolist = n; }
 
+    bool SinglePass() const { return singlepass; }
+    void SetSinglePass(bool s) { singlepass = s; }
+
+    bool Stream() const { return stream; }
+    void SetStream(bool s) { stream = s; }
+
+    int Jobs() const { return jobs; }
+    void SetJobs(int n) { jobs = n >= 1 ? n : 1; }
+
     int IsDebug(int flag) const { return debug & flag; }
     void SetDebug(int d);
     
@@ -85,11 +105,20 @@ public:
     
     const char* P2File();
     void SetP2File(const char* name);
+
+    const char* CacheFile() const { return cachefile; }
+    void SetCacheFile(const char* name);
+
+    /* socket of server mode (-L) or of server to use (-R) */
+    const char* SockFile() const { return sockfile; }
+    bool Serve() const { return serve; }
+    void SetSockFile(const char* name, bool serve);
+
+    const char* BatchFile() const { return batchfile; }
+    void SetBatchFile(const char* name);
     
     const char* CurFile() const { return curfile; }
     void SetCurFile(const char* fi);
 };
 
-extern Settings* set;
-
 #endif
@@ -0,0 +1,96 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "amdasm.h"
+#include "y.tab.h"
+
+/* pseudo tokens for the listing */
+#define TAPE_TEXT   -1
+#define TAPE_FLUSH  -2
+
+struct TapeEntry
+{
+    int op;             /* token, or TAPE_TEXT/TAPE_FLUSH */
+    int len;            /* length of TAPE_TEXT */
+    union {
+        const char* text;
+        YYSTYPE val;
+    };
+};
+
+Tape::Tape()
+    : n(0), max(4096)
+{
+    ent = new TapeEntry[max];
+}
+
+Tape::~Tape()
+{
+    delete[] ent;
+}
+
+TapeEntry* Tape::add(int op)
+{
+    if (n >= max) {
+        TapeEntry* nent = new TapeEntry[max*2];
+        memcpy(nent, ent, n * sizeof(TapeEntry));
+        delete[] ent;
+        ent = nent;
+        max *= 2;
+    }
+    TapeEntry* e = &ent[n++];
+    e->op = op;
+    e->len = 0;
+    return e;
+}
+
+void Tape::Token(int tok, const YYSTYPE* val)
+{
+    add(tok)->val = *val;
+}
+
+void Tape::Text(const char* s, int len)
+{
+    TapeEntry* e = add(TAPE_TEXT);
+    e->text = s;
+    e->len = len;
+}
+
+void Tape::Flush()
+{
+    add(TAPE_FLUSH);
+}
+
+/* return the next token before end, and list the text up to there */
+int Tape::Replay(YYSTYPE* val, Printer* p, int* pos, int end) const
+{
+    while (*pos < end) {
+        const TapeEntry* e = &ent[(*pos)++];
+        switch (e->op) {
+        case TAPE_TEXT:
+            p->Collect(e->text, e->len);
+            break;
+        case TAPE_FLUSH:
+            p->Flush();
+            break;
+        default:
+            *val = e->val;
+            return e->op;
+        }
+    }
+    return 0;
+}
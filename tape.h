@@ -0,0 +1,48 @@
+/*
+ *   This file is part of the AMD Microassembler Clone software.
+ *   Copyright (C) 2019  Holger Veit <hveit01@web.de>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef __TAPE_H__
+#define __TAPE_H__
+
+union YYSTYPE;
+struct TapeEntry;
+
+/* Tokens of the SRC, as scanned in phase 2a, together with the text
+ * collected for the listing between them. Phase 2b reads the tokens
+ * from here instead of scanning the SRC again. Listing text refers
+ * to the mapped SRC, token strings are those of phase 2a. */
+class Tape
+{
+protected:
+    TapeEntry* ent;
+    int n, max;
+    
+    TapeEntry* add(int op);
+public:
+    Tape();
+    ~Tape();
+    
+    int Size() const { return n; }
+
+    void Token(int tok, const YYSTYPE* val);
+    void Text(const char* s, int len);
+    void Flush();
+    
+    int Replay(YYSTYPE* val, Printer* p, int* pos, int end) const;
+};
+
+#endif
@@ -24,21 +24,35 @@ char* copystr(const char* str)
     return s;
 }
 
-void yyerror(const char* msg)
+void yyerror(Context* c, const char* msg)
 {
     char errmsg[4096];
     
-    const char* line = p->Linebuf();
+    /* a worker leaves diagnostics to the serial rerun of its chunk */
+    if (c->Worker()) {
+        c->failed = true;
+        return;
+    }
+
+    const char* line = c->p->Linebuf();
     int col = strlen(line);
     sprintf(errmsg, "--- %s:%d:%d: error: %s\n"
                     "--- %s\n"
                     "--- %*s^~~~~~\n",
-                    set->CurFile(), p->Lineno(), col, msg,
+                    c->set->CurFile(), c->p->Lineno(), col, msg,
                     line,
                     col, "");
 
-	p->AddError(errmsg);
-    fprintf(stderr,"%s", errmsg);        
+	c->p->AddError(errmsg);
+    if (c->lib)
+        c->lib->Error(c->set->CurFile(), c->p->Lineno(), col, msg);
+    else
+        fprintf(stderr,"%s", errmsg);        
+}
+
+void yyerror(const char* msg)
+{
+    yyerror(ctx, msg);
 }
 
 void verbose(const char* fmt, ...)
@@ -46,22 +60,17 @@ void verbose(const char* fmt, ...)
     va_list ap;
     va_start(ap, fmt);
     
-    if (set->IsDebug(DBG_VERBOSE))
+    if (ctx->set->IsDebug(DBG_VERBOSE))
         vfprintf(stderr, fmt, ap);
 }
 
-int yywrap()
-{
-	return 1;
-}
-
 int parse_file(int phase) 
 {
     char marker;
     const char* infile;
     const char* pfile;
     
-    Settings* s = Settings::Instance();    
+    Settings* s = ctx->set;
     s->SetPhase(phase);
     
     const char* phname;
@@ -83,55 +92,94 @@ int parse_file(int phase)
         infile = s->SrcFile();
         pfile = s->P2File();
         phase = 2;
-        phname = "2b";
+        phname = s->SinglePass() ? "2, single pass" : "2b";
     }
     
 	verbose("*** Parsing %s (Phase %s)\n", infile, phname);
-    p = new Printer(pfile, phase); 
+    Printer* p = ctx->p = new Printer(pfile, phase);
 
     s->SetCurFile(infile);
-	yyin = fopen(infile, "r");
-    if (yyin == 0) {
-        fprintf(stderr,"*** File %s does not exist\n", infile);
-        exit(1);
-    } else {
-        fseek(yyin, 0, SEEK_END);
-        if (ftell(yyin) == 0) {
-            fprintf(stderr,"File %s is empty\n", infile);
-            exit(1);
-        }
-        fseek(yyin, 0, SEEK_SET);
+    Input* in = Input::Open(infile);
+    if (in == 0) {
+        if (ctx->lib) ctx->lib->Error(infile, 0, 0, "File does not exist");
+        else fprintf(stderr,"*** File %s does not exist\n", infile);
+        fatal(1);
+    } else if (in->Size() == 0) {
+        if (ctx->lib) ctx->lib->Error(infile, 0, 0, "File is empty");
+        else fprintf(stderr,"File %s is empty\n", infile);
+        fatal(1);
     }
     
-	ungetc(marker, yyin);
-	yyparse();
-	fclose(yyin);
+    if (marker == '}') {
+        ctx->streaming = Output::Streaming(ctx);
+        if (ctx->streaming)
+            Output::Open();
+        else if (s->Stream())
+            verbose("*** Output files are written at the end, -w needs -n\n");
+    }
+    if (marker == '}' && ctx->chunks)
+        Chunk::Assemble(ctx);
+    else {
+        if (marker == '|') {
+            ctx->tape = new Tape();
+            if (Chunk::Parallel(ctx))
+                Chunk::Start(ctx, in);
+        }
+        if (marker == '}' && ctx->tape)
+            scan_tape(ctx, 0, ctx->tape->Size(), true);
+        else
+            scan_input(ctx, in, marker);
+        yyparse(ctx);
+        scan_end(ctx);
+    }
     p->Flush();
     
     int errors = p->Errors();
 	if (errors) {
-		fprintf(stderr,
+        if (!ctx->lib) fprintf(stderr,
             "\n*** Failed to parse %s: %d error(s)\n", infile, errors);
+        if (ctx->streaming) Output::Abort();
 	} else if (marker=='}') {
+        /* pack the lines, the Lineouts are no longer needed */
+        ctx->words = new Words(Lineout::First());
+        ctx->lroot = 0;
+        ctx->arena->Release();
         p->PrintMap();
         p->PrintSymbols();
         Output::Dump();
     }
 
-    delete p; p = 0;
+    delete p; ctx->p = 0;
 	return errors;
 }
 
 int internal_error(const char* at, int line)
 {
-    fprintf(stderr,"In FILE=\"%s\", LINE=%d: Internal error\n",
-        at, line);
-    exit(99);
+    if (ctx && ctx->Worker()) {
+        ctx->failed = true;
+        return 0;
+    }
+    if (ctx && ctx->lib)
+        ctx->lib->Error(at, line, 0, "Internal error");
+    else
+        fprintf(stderr,"In FILE=\"%s\", LINE=%d: Internal error\n",
+            at, line);
+    fatal(99);
 	
 	/*NOTREACHED*/
 	return 0;
 }
 
+/* can't continue: return from the library call or batch job, or exit */
+void fatal(int code)
+{
+    if (ctx)
+        Output::Abort();
+    if (ctx && ctx->bailout)
+        longjmp(*ctx->bailout, code);
+    exit(code);
+}
+
 /* convert a number into a binary value - the before used itoa() is non-portable :-( */
 char* bin2str(int value, char* buf)
 {
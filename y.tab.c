@@ -0,0 +1,2280 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 19 "amdasm.y"
+
+#include "amdasm.h"
+#include "data.h"
+
+/* single pass mode: a label and an EQU of the same name would resolve
+ * differently in phases 2a and 2b, so reject them here */
+static void enter_label(Context* ctx, const Ident* name, bool entry)
+{
+    Symbol* s = ctx->symtab->Lookup(name);
+    if (s && s->IsA()==ISA_EQU)
+        yyerror("Label and EQU of same name in single pass mode");
+    ctx->labels->Enter(new Label(name->text, ctx->set->LocPtr(), entry));
+}
+
+static void enter_equ(Context* ctx, const Ident* name, const Fdecl& val)
+{
+    if (val.fmt & F_FWD) {
+        yyerror("Undeclared NAME");
+        return;
+    }
+    if (ctx->labels->Lookup(name))
+        yyerror("Label and EQU of same name in single pass mode");
+    Equ* vequ = new Equ(name->text, val);
+    ctx->symtab->Enter(vequ);
+    if (ctx->set->IsDebug(DBG_DEFS))
+        vequ->Debug();
+}
+
+/* substitute VFS argument, or defer it if it is a forward reference */
+static void subst_arg(Context* ctx, const Fdecl& arg)
+{
+    if (arg.fmt & F_FWD)
+        ctx->outline->DeferArg(ctx->fwdname, arg);
+    else
+        ctx->outline->SubstArg(arg);
+}
+
+/* a forward reference may only be offset by a constant */
+static int fwd_expr(const Fdecl& l, const Fdecl& r, bool left, bool right)
+{
+    bool fl = (l.fmt & F_FWD) != 0;
+    bool fr = (r.fmt & F_FWD) != 0;
+    if (!fl && !fr) return 0;
+    if ((fl && fr) || (fl && !left) || (fr && !right)) {
+        yyerror("Invalid use of forward reference");
+        return 0;
+    }
+    return F_FWD;
+}
+
+#line 122 "y.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+/* Use api.header.include to #include this header
+   instead of duplicating it here.  */
+#ifndef YY_YY_Y_TAB_H_INCLUDED
+# define YY_YY_Y_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 1
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+/* "%code requires" blocks.  */
+#line 74 "amdasm.y"
+
+class Context;
+struct Ident;
+
+#line 162 "y.tab.c"
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    NL = 258,                      /* NL  */
+    CONST = 259,                   /* CONST  */
+    NUMBER = 260,                  /* NUMBER  */
+    DCFIELD = 261,                 /* DCFIELD  */
+    VARFIELD = 262,                /* VARFIELD  */
+    ALIGN = 263,                   /* ALIGN  */
+    EJECT = 264,                   /* EJECT  */
+    END = 265,                     /* END  */
+    EQU = 266,                     /* EQU  */
+    FF = 267,                      /* FF  */
+    LIST = 268,                    /* LIST  */
+    NOLIST = 269,                  /* NOLIST  */
+    ORG = 270,                     /* ORG  */
+    RES = 271,                     /* RES  */
+    SPACE = 272,                   /* SPACE  */
+    DEFFMT = 273,                  /* DEFFMT  */
+    TITLE = 274,                   /* TITLE  */
+    DEF = 275,                     /* DEF  */
+    SUB = 276,                     /* SUB  */
+    XOPT = 277,                    /* XOPT  */
+    WORD = 278,                    /* WORD  */
+    NAME = 279,                    /* NAME  */
+    ENTRY = 280,                   /* ENTRY  */
+    LABEL = 281,                   /* LABEL  */
+    COMMA = 282,                   /* COMMA  */
+    AMPERSAND = 283,               /* AMPERSAND  */
+    COLON = 284,                   /* COLON  */
+    PERCENT = 285,                 /* PERCENT  */
+    DOLLAR = 286,                  /* DOLLAR  */
+    LPAREN = 287,                  /* LPAREN  */
+    RPAREN = 288,                  /* RPAREN  */
+    DEFMARK = 289,                 /* DEFMARK  */
+    SRCMARK1 = 290,                /* SRCMARK1  */
+    SRCMARK2 = 291,                /* SRCMARK2  */
+    SRCCHUNK = 292,                /* SRCCHUNK  */
+    COLS = 293,                    /* COLS  */
+    PLUS = 294,                    /* PLUS  */
+    MINUS = 295,                   /* MINUS  */
+    TIMES = 296,                   /* TIMES  */
+    SLASH = 297                    /* SLASH  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 84 "amdasm.y"
+
+	int   fmt;
+	char* str;
+	const Ident* name;
+	Fdecl fdecl;
+
+#line 228 "y.tab.c"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+
+
+int yyparse (Context* ctx);
+
+/* "%code provides" blocks.  */
+#line 79 "amdasm.y"
+
+extern int yylex(YYSTYPE* lval, Context* ctx);
+
+#line 246 "y.tab.c"
+
+#endif /* !YY_YY_Y_TAB_H_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_NL = 3,                         /* NL  */
+  YYSYMBOL_CONST = 4,                      /* CONST  */
+  YYSYMBOL_NUMBER = 5,                     /* NUMBER  */
+  YYSYMBOL_DCFIELD = 6,                    /* DCFIELD  */
+  YYSYMBOL_VARFIELD = 7,                   /* VARFIELD  */
+  YYSYMBOL_ALIGN = 8,                      /* ALIGN  */
+  YYSYMBOL_EJECT = 9,                      /* EJECT  */
+  YYSYMBOL_END = 10,                       /* END  */
+  YYSYMBOL_EQU = 11,                       /* EQU  */
+  YYSYMBOL_FF = 12,                        /* FF  */
+  YYSYMBOL_LIST = 13,                      /* LIST  */
+  YYSYMBOL_NOLIST = 14,                    /* NOLIST  */
+  YYSYMBOL_ORG = 15,                       /* ORG  */
+  YYSYMBOL_RES = 16,                       /* RES  */
+  YYSYMBOL_SPACE = 17,                     /* SPACE  */
+  YYSYMBOL_DEFFMT = 18,                    /* DEFFMT  */
+  YYSYMBOL_TITLE = 19,                     /* TITLE  */
+  YYSYMBOL_DEF = 20,                       /* DEF  */
+  YYSYMBOL_SUB = 21,                       /* SUB  */
+  YYSYMBOL_XOPT = 22,                      /* XOPT  */
+  YYSYMBOL_WORD = 23,                      /* WORD  */
+  YYSYMBOL_NAME = 24,                      /* NAME  */
+  YYSYMBOL_ENTRY = 25,                     /* ENTRY  */
+  YYSYMBOL_LABEL = 26,                     /* LABEL  */
+  YYSYMBOL_COMMA = 27,                     /* COMMA  */
+  YYSYMBOL_AMPERSAND = 28,                 /* AMPERSAND  */
+  YYSYMBOL_COLON = 29,                     /* COLON  */
+  YYSYMBOL_PERCENT = 30,                   /* PERCENT  */
+  YYSYMBOL_DOLLAR = 31,                    /* DOLLAR  */
+  YYSYMBOL_LPAREN = 32,                    /* LPAREN  */
+  YYSYMBOL_RPAREN = 33,                    /* RPAREN  */
+  YYSYMBOL_DEFMARK = 34,                   /* DEFMARK  */
+  YYSYMBOL_SRCMARK1 = 35,                  /* SRCMARK1  */
+  YYSYMBOL_SRCMARK2 = 36,                  /* SRCMARK2  */
+  YYSYMBOL_SRCCHUNK = 37,                  /* SRCCHUNK  */
+  YYSYMBOL_COLS = 38,                      /* COLS  */
+  YYSYMBOL_PLUS = 39,                      /* PLUS  */
+  YYSYMBOL_MINUS = 40,                     /* MINUS  */
+  YYSYMBOL_TIMES = 41,                     /* TIMES  */
+  YYSYMBOL_SLASH = 42,                     /* SLASH  */
+  YYSYMBOL_YYACCEPT = 43,                  /* $accept  */
+  YYSYMBOL_start = 44,                     /* start  */
+  YYSYMBOL_45_1 = 45,                      /* $@1  */
+  YYSYMBOL_deffile = 46,                   /* deffile  */
+  YYSYMBOL_emptylines = 47,                /* emptylines  */
+  YYSYMBOL_def_stmts = 48,                 /* def_stmts  */
+  YYSYMBOL_printctrl_stmt = 49,            /* printctrl_stmt  */
+  YYSYMBOL_50_2 = 50,                      /* $@2  */
+  YYSYMBOL_equ_stmt = 51,                  /* equ_stmt  */
+  YYSYMBOL_microword_stmt = 52,            /* microword_stmt  */
+  YYSYMBOL_53_3 = 53,                      /* $@3  */
+  YYSYMBOL_subword_stmt = 54,              /* subword_stmt  */
+  YYSYMBOL_55_4 = 55,                      /* $@4  */
+  YYSYMBOL_label = 56,                     /* label  */
+  YYSYMBOL_def_stmt = 57,                  /* def_stmt  */
+  YYSYMBOL_cols_extension = 58,            /* cols_extension  */
+  YYSYMBOL_cols_list = 59,                 /* cols_list  */
+  YYSYMBOL_fieldlist = 60,                 /* fieldlist  */
+  YYSYMBOL_field = 61,                     /* field  */
+  YYSYMBOL_62_5 = 62,                      /* $@5  */
+  YYSYMBOL_constant = 63,                  /* constant  */
+  YYSYMBOL_expr = 64,                      /* expr  */
+  YYSYMBOL_opt_vattr = 65,                 /* opt_vattr  */
+  YYSYMBOL_opt_defval = 66,                /* opt_defval  */
+  YYSYMBOL_opt_vmod = 67,                  /* opt_vmod  */
+  YYSYMBOL_srcfile1 = 68,                  /* srcfile1  */
+  YYSYMBOL_69_6 = 69,                      /* $@6  */
+  YYSYMBOL_src_stmts1 = 70,                /* src_stmts1  */
+  YYSYMBOL_src_stmt1 = 71,                 /* src_stmt1  */
+  YYSYMBOL_label1 = 72,                    /* label1  */
+  YYSYMBOL_opt_label1 = 73,                /* opt_label1  */
+  YYSYMBOL_equ_stmt1 = 74,                 /* equ_stmt1  */
+  YYSYMBOL_exec_stmt1 = 75,                /* exec_stmt1  */
+  YYSYMBOL_fffieldlist1 = 76,              /* fffieldlist1  */
+  YYSYMBOL_fffield1 = 77,                  /* fffield1  */
+  YYSYMBOL_overlayformat1 = 78,            /* overlayformat1  */
+  YYSYMBOL_overlayformat_list1 = 79,       /* overlayformat_list1  */
+  YYSYMBOL_opt_vfslist1 = 80,              /* opt_vfslist1  */
+  YYSYMBOL_expr1 = 81,                     /* expr1  */
+  YYSYMBOL_srcfile2 = 82,                  /* srcfile2  */
+  YYSYMBOL_83_7 = 83,                      /* $@7  */
+  YYSYMBOL_84_8 = 84,                      /* $@8  */
+  YYSYMBOL_src_stmts2 = 85,                /* src_stmts2  */
+  YYSYMBOL_src_stmt2 = 86,                 /* src_stmt2  */
+  YYSYMBOL_equ_stmt2 = 87,                 /* equ_stmt2  */
+  YYSYMBOL_label2 = 88,                    /* label2  */
+  YYSYMBOL_opt_label2 = 89,                /* opt_label2  */
+  YYSYMBOL_exec_stmt = 90,                 /* exec_stmt  */
+  YYSYMBOL_91_9 = 91,                      /* $@9  */
+  YYSYMBOL_fffieldlist2 = 92,              /* fffieldlist2  */
+  YYSYMBOL_fffield2 = 93,                  /* fffield2  */
+  YYSYMBOL_94_10 = 94,                     /* $@10  */
+  YYSYMBOL_95_11 = 95,                     /* $@11  */
+  YYSYMBOL_overlayformat2 = 96,            /* overlayformat2  */
+  YYSYMBOL_97_12 = 97,                     /* $@12  */
+  YYSYMBOL_overlayformat_list2 = 98,       /* overlayformat_list2  */
+  YYSYMBOL_opt_vfslist2 = 99,              /* opt_vfslist2  */
+  YYSYMBOL_expr2 = 100                     /* expr2  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  13
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   259
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  43
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  58
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  152
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  231
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   297
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   117,   117,   118,   119,   120,   120,   125,   131,   132,
+     137,   138,   142,   143,   143,   144,   145,   146,   147,   151,
+     159,   159,   171,   171,   179,   180,   185,   186,   187,   188,
+     189,   190,   191,   195,   205,   206,   210,   211,   215,   216,
+     216,   219,   223,   227,   228,   229,   233,   234,   237,   238,
+     239,   240,   241,   245,   246,   247,   248,   249,   250,   251,
+     255,   256,   257,   261,   262,   263,   264,   265,   272,   271,
+     277,   278,   282,   283,   284,   285,   286,   287,   288,   289,
+     290,   291,   292,   297,   298,   302,   303,   307,   315,   316,
+     320,   321,   325,   326,   328,   329,   333,   337,   338,   342,
+     343,   344,   345,   349,   350,   351,   352,   353,   354,   355,
+     361,   363,   361,   368,   369,   373,   374,   375,   376,   377,
+     378,   382,   392,   393,   397,   398,   402,   402,   408,   412,
+     413,   417,   420,   420,   430,   436,   447,   447,   452,   452,
+     459,   460,   464,   465,   466,   467,   471,   472,   487,   488,
+     489,   490,   491
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "NL", "CONST",
+  "NUMBER", "DCFIELD", "VARFIELD", "ALIGN", "EJECT", "END", "EQU", "FF",
+  "LIST", "NOLIST", "ORG", "RES", "SPACE", "DEFFMT", "TITLE", "DEF", "SUB",
+  "XOPT", "WORD", "NAME", "ENTRY", "LABEL", "COMMA", "AMPERSAND", "COLON",
+  "PERCENT", "DOLLAR", "LPAREN", "RPAREN", "DEFMARK", "SRCMARK1",
+  "SRCMARK2", "SRCCHUNK", "COLS", "PLUS", "MINUS", "TIMES", "SLASH",
+  "$accept", "start", "$@1", "deffile", "emptylines", "def_stmts",
+  "printctrl_stmt", "$@2", "equ_stmt", "microword_stmt", "$@3",
+  "subword_stmt", "$@4", "label", "def_stmt", "cols_extension",
+  "cols_list", "fieldlist", "field", "$@5", "constant", "expr",
+  "opt_vattr", "opt_defval", "opt_vmod", "srcfile1", "$@6", "src_stmts1",
+  "src_stmt1", "label1", "opt_label1", "equ_stmt1", "exec_stmt1",
+  "fffieldlist1", "fffield1", "overlayformat1", "overlayformat_list1",
+  "opt_vfslist1", "expr1", "srcfile2", "$@7", "$@8", "src_stmts2",
+  "src_stmt2", "equ_stmt2", "label2", "opt_label2", "exec_stmt", "$@9",
+  "fffieldlist2", "fffield2", "$@10", "$@11", "overlayformat2", "$@12",
+  "overlayformat_list2", "opt_vfslist2", "expr2", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-173)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-26)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+     199,  -173,  -173,  -173,  -173,    10,  -173,   117,  -173,   181,
+    -173,  -173,  -173,  -173,    33,  -173,    49,    52,    59,    80,
+       8,  -173,    23,  -173,  -173,    85,  -173,    88,    89,    97,
+      95,  -173,   108,  -173,    25,   110,  -173,   114,   116,    25,
+      25,    93,   118,    22,   111,   126,  -173,  -173,    27,   122,
+     200,   162,  -173,  -173,    52,  -173,  -173,  -173,   125,   135,
+     136,   102,  -173,  -173,  -173,  -173,    25,  -173,  -173,  -173,
+    -173,   137,  -173,  -173,  -173,     1,  -173,    52,  -173,  -173,
+       5,    24,   142,  -173,    25,   148,    30,   153,  -173,   123,
+    -173,    25,  -173,    25,    25,    22,   111,  -173,   149,  -173,
+     158,  -173,    75,  -173,  -173,  -173,  -173,    85,   209,    14,
+      14,  -173,  -173,    25,    25,    25,    25,  -173,  -173,  -173,
+    -173,   209,  -173,   131,  -173,   139,  -173,  -173,  -173,  -173,
+     146,   213,  -173,   140,    28,    52,    55,    68,    81,  -173,
+    -173,  -173,   171,  -173,   152,  -173,  -173,  -173,  -173,   155,
+    -173,  -173,   155,  -173,  -173,  -173,  -173,    30,   148,    30,
+      30,    30,    30,    30,  -173,  -173,  -173,  -173,  -173,  -173,
+    -173,  -173,   217,   143,    81,  -173,   159,  -173,    14,   188,
+    -173,   213,  -173,  -173,  -173,  -173,    81,    81,    81,    81,
+    -173,  -173,   154,  -173,   165,  -173,   166,   217,  -173,   128,
+    -173,  -173,  -173,  -173,  -173,  -173,   172,  -173,   143,    81,
+    -173,  -173,  -173,  -173,  -173,  -173,  -173,  -173,  -173,  -173,
+      81,  -173,   217,   -18,   -18,   198,  -173,  -173,  -173,  -173,
+    -173
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       0,    10,    70,   110,     5,     0,     2,     0,     3,    85,
+       4,   113,   113,     1,     0,    12,     0,     8,     0,     0,
+       0,    13,     0,    25,    24,     0,    26,     0,     0,     0,
+       0,    11,     0,    72,     0,     0,    68,     0,     0,     0,
+       0,     0,     0,    84,    83,     0,    71,    86,     0,     0,
+     124,   124,    32,    18,     8,     7,    15,    16,     0,     0,
+       0,    34,    33,    28,    29,    30,     0,    20,    22,    31,
+      44,    45,    47,    48,    46,     0,    77,     8,    74,    75,
+       0,     0,     0,    73,     0,     0,    99,     0,    97,    89,
+      78,     0,   111,     0,     0,   123,   122,   115,     0,   114,
+       0,   125,     0,     9,    17,    14,    27,     0,    19,     0,
+       0,    43,    81,     0,     0,     0,     0,    69,    79,    80,
+      76,    87,    92,    95,    94,    88,    90,   104,   105,   103,
+      96,   100,    82,     0,     0,     8,     0,     0,     0,   116,
+     126,   138,     0,   140,   128,    35,    38,    39,    42,    21,
+      36,    41,    23,    49,    50,    51,    52,     0,     0,   102,
+       0,     0,     0,     0,    98,   119,   112,   117,   118,   147,
+     148,   146,   121,     0,   142,   120,     0,    53,     0,     0,
+      91,   101,   106,   107,   108,   109,     0,     0,     0,     0,
+     136,   131,   135,   134,   127,   129,   139,   143,   141,    60,
+      37,    93,   149,   150,   151,   152,     0,   132,     0,   145,
+      63,    59,    57,    54,    58,    56,    55,    63,    40,   137,
+       0,   130,   144,    61,    62,     0,    67,    64,    66,    65,
+     133
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -173,  -173,  -173,  -173,   -51,  -173,   178,  -173,  -173,  -173,
+    -173,  -173,  -173,     0,  -173,  -173,    94,    92,    26,  -173,
+     -85,   -34,  -173,  -173,   -12,  -173,  -173,  -173,  -173,  -173,
+    -173,  -173,  -173,  -173,    53,    79,  -173,  -173,    84,  -173,
+    -173,  -173,   206,  -173,  -173,  -173,  -173,  -173,  -173,  -173,
+      12,  -173,  -173,    46,  -173,  -173,  -173,  -172
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,     5,    12,     6,    55,     7,    97,    59,    27,    28,
+     109,    29,   110,    98,    31,    32,    62,   149,   150,   177,
+      74,    75,   199,   218,   223,     8,    77,     9,    46,    47,
+      48,    49,    87,   125,   126,    88,    89,   130,   131,    10,
+      11,   135,    50,    99,   100,   101,   102,   142,   173,   194,
+     195,   220,   206,   143,   174,   144,   196,   172
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+     124,   129,   197,   103,   112,    80,    81,    30,   118,    45,
+      13,   226,   227,    58,   202,   203,   204,   205,    70,    71,
+     146,   147,   228,   229,   151,   151,   117,   119,    60,    70,
+      71,   165,   108,   -25,    70,    71,    52,   222,   148,    85,
+     113,   114,   115,   116,   113,   114,   115,   116,   225,    72,
+     121,    86,    53,   171,   127,    54,    73,   134,   167,   136,
+     137,   128,    56,   113,   114,   115,   116,   113,   114,   115,
+     116,   168,   129,   124,   129,   129,   129,   129,   129,   153,
+     154,   155,   156,    57,   166,    70,    71,   140,   193,   171,
+      61,    63,    64,   151,   113,   114,   115,   116,    82,   141,
+      65,   171,   171,   171,   171,   169,    66,   113,   114,   115,
+     116,    69,   170,    76,   217,    67,    68,    78,    14,    79,
+      15,    83,   -24,   193,   171,    90,    16,    17,   104,   107,
+      18,    19,    70,    71,    20,   171,    21,    84,   105,   106,
+      22,   111,    23,    24,   190,   120,   210,    70,    71,   191,
+     211,   133,    70,    71,   122,    25,   132,   212,   213,   214,
+     138,   139,    -6,   157,    86,    15,   158,   192,   215,   216,
+      91,    16,   123,   159,   175,    18,    19,    93,    94,    20,
+     176,    21,   178,   141,    33,    26,   207,    95,    96,    34,
+      35,    36,   208,   209,    37,    38,    39,    40,    41,   219,
+      42,   145,   152,    15,   200,   224,    43,    44,    91,    16,
+      92,   180,   164,    18,    19,    93,    94,    20,    51,    21,
+     221,   201,   198,     0,     0,    95,    96,   160,   161,   162,
+     163,   230,     0,     1,     2,     3,     4,   186,   187,   188,
+     189,   179,     0,   181,   182,   183,   184,   185,   113,   114,
+     115,   116,   160,   161,   162,   163,   186,   187,   188,   189
+};
+
+static const yytype_int16 yycheck[] =
+{
+      85,    86,   174,    54,     3,    39,    40,     7,     3,     9,
+       0,    29,    30,     5,   186,   187,   188,   189,     4,     5,
+       6,     7,    40,    41,   109,   110,    77,     3,     5,     4,
+       5,     3,    66,    11,     4,     5,     3,   209,    24,    12,
+      39,    40,    41,    42,    39,    40,    41,    42,   220,    24,
+      84,    24,     3,   138,    24,     3,    31,    91,     3,    93,
+      94,    31,     3,    39,    40,    41,    42,    39,    40,    41,
+      42,     3,   157,   158,   159,   160,   161,   162,   163,   113,
+     114,   115,   116,     3,   135,     4,     5,    12,   173,   174,
+       5,     3,     3,   178,    39,    40,    41,    42,     5,    24,
+       3,   186,   187,   188,   189,    24,    11,    39,    40,    41,
+      42,     3,    31,     3,   199,    20,    21,     3,     1,     3,
+       3,     3,    11,   208,   209,     3,     9,    10,     3,    27,
+      13,    14,     4,     5,    17,   220,    19,    11,     3,     3,
+      23,     4,    25,    26,     1,     3,    18,     4,     5,     6,
+      22,    28,     4,     5,     6,    38,     3,    29,    30,    31,
+      11,     3,     0,    32,    24,     3,    27,    24,    40,    41,
+       8,     9,    24,    27,     3,    13,    14,    15,    16,    17,
+      28,    19,    27,    24,     3,     7,    32,    25,    26,     8,
+       9,    10,    27,    27,    13,    14,    15,    16,    17,    27,
+      19,   107,   110,     3,   178,   217,    25,    26,     8,     9,
+      10,   158,   133,    13,    14,    15,    16,    17,    12,    19,
+     208,    33,   176,    -1,    -1,    25,    26,    39,    40,    41,
+      42,    33,    -1,    34,    35,    36,    37,    39,    40,    41,
+      42,   157,    -1,   159,   160,   161,   162,   163,    39,    40,
+      41,    42,    39,    40,    41,    42,    39,    40,    41,    42
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,    34,    35,    36,    37,    44,    46,    48,    68,    70,
+      82,    83,    45,     0,     1,     3,     9,    10,    13,    14,
+      17,    19,    23,    25,    26,    38,    49,    51,    52,    54,
+      56,    57,    58,     3,     8,     9,    10,    13,    14,    15,
+      16,    17,    19,    25,    26,    56,    71,    72,    73,    74,
+      85,    85,     3,     3,     3,    47,     3,     3,     5,    50,
+       5,     5,    59,     3,     3,     3,    11,    20,    21,     3,
+       4,     5,    24,    31,    63,    64,     3,    69,     3,     3,
+      64,    64,     5,     3,    11,    12,    24,    75,    78,    79,
+       3,     8,    10,    15,    16,    25,    26,    49,    56,    86,
+      87,    88,    89,    47,     3,     3,     3,    27,    64,    53,
+      55,     4,     3,    39,    40,    41,    42,    47,     3,     3,
+       3,    64,     6,    24,    63,    76,    77,    24,    31,    63,
+      80,    81,     3,    28,    64,    84,    64,    64,    11,     3,
+      12,    24,    90,    96,    98,    59,     6,     7,    24,    60,
+      61,    63,    60,    64,    64,    64,    64,    32,    27,    27,
+      39,    40,    41,    42,    78,     3,    47,     3,     3,    24,
+      31,    63,   100,    91,    97,     3,    28,    62,    27,    81,
+      77,    81,    81,    81,    81,    81,    39,    40,    41,    42,
+       1,     6,    24,    63,    92,    93,    99,   100,    96,    65,
+      61,    33,   100,   100,   100,   100,    95,    32,    27,    27,
+      18,    22,    29,    30,    31,    40,    41,    63,    66,    27,
+      94,    93,   100,    67,    67,   100,    29,    30,    40,    41,
+      33
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    43,    44,    44,    44,    45,    44,    46,    47,    47,
+      48,    48,    49,    50,    49,    49,    49,    49,    49,    51,
+      53,    52,    55,    54,    56,    56,    57,    57,    57,    57,
+      57,    57,    57,    58,    59,    59,    60,    60,    61,    62,
+      61,    61,    61,    63,    63,    63,    64,    64,    64,    64,
+      64,    64,    64,    65,    65,    65,    65,    65,    65,    65,
+      66,    66,    66,    67,    67,    67,    67,    67,    69,    68,
+      70,    70,    71,    71,    71,    71,    71,    71,    71,    71,
+      71,    71,    71,    72,    72,    73,    73,    74,    75,    75,
+      76,    76,    77,    77,    77,    77,    78,    79,    79,    80,
+      80,    80,    80,    81,    81,    81,    81,    81,    81,    81,
+      83,    84,    82,    85,    85,    86,    86,    86,    86,    86,
+      86,    87,    88,    88,    89,    89,    91,    90,    90,    92,
+      92,    93,    94,    93,    93,    93,    95,    93,    97,    96,
+      98,    98,    99,    99,    99,    99,   100,   100,   100,   100,
+     100,   100,   100
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     2,     2,     2,     0,     3,     3,     0,     2,
+       0,     2,     1,     0,     3,     2,     2,     3,     2,     3,
+       0,     4,     0,     4,     1,     1,     1,     3,     2,     2,
+       2,     2,     2,     2,     1,     3,     1,     3,     1,     0,
+       4,     1,     1,     2,     1,     1,     1,     1,     1,     3,
+       3,     3,     3,     0,     2,     2,     2,     2,     2,     2,
+       0,     2,     2,     0,     2,     2,     2,     2,     0,     4,
+       0,     2,     1,     2,     2,     2,     3,     2,     2,     3,
+       3,     3,     3,     1,     1,     0,     1,     3,     2,     1,
+       1,     3,     1,     4,     1,     1,     2,     1,     3,     0,
+       1,     3,     2,     1,     1,     1,     3,     3,     3,     3,
+       0,     0,     5,     0,     2,     1,     2,     3,     3,     3,
+       3,     3,     1,     1,     0,     1,     0,     3,     1,     1,
+       3,     1,     0,     5,     1,     1,     0,     3,     0,     3,
+       1,     3,     0,     1,     3,     2,     1,     1,     1,     3,
+       3,     3,     3
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (ctx, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, ctx); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, Context* ctx)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (ctx);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, Context* ctx)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep, ctx);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, Context* ctx)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], ctx);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, ctx); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, Context* ctx)
+{
+  YY_USE (yyvaluep);
+  YY_USE (ctx);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (Context* ctx)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, ctx);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 5: /* $@1: %empty  */
+#line 120 "amdasm.y"
+                          { ctx->outline = 0; }
+#line 1499 "y.tab.c"
+    break;
+
+  case 13: /* $@2: %empty  */
+#line 143 "amdasm.y"
+                        { ctx->p->SetTitle((yyvsp[0].str)); }
+#line 1505 "y.tab.c"
+    break;
+
+  case 15: /* printctrl_stmt: LIST NL  */
+#line 144 "amdasm.y"
+                        { ctx->p->List(); }
+#line 1511 "y.tab.c"
+    break;
+
+  case 16: /* printctrl_stmt: NOLIST NL  */
+#line 145 "amdasm.y"
+                        { ctx->p->Nolist(); }
+#line 1517 "y.tab.c"
+    break;
+
+  case 17: /* printctrl_stmt: SPACE NUMBER NL  */
+#line 146 "amdasm.y"
+                        { ctx->p->Space((yyvsp[-1].fdecl).value); }
+#line 1523 "y.tab.c"
+    break;
+
+  case 18: /* printctrl_stmt: EJECT NL  */
+#line 147 "amdasm.y"
+                        { ctx->p->Eject(); }
+#line 1529 "y.tab.c"
+    break;
+
+  case 19: /* equ_stmt: label EQU expr  */
+#line 151 "amdasm.y"
+                        { Equ* vequ = new Equ((yyvsp[-2].name)->text, (yyvsp[0].fdecl));
+                      ctx->symtab->Enter(vequ);
+                      if (ctx->set->IsDebug(DBG_DEFS))
+                        vequ->Debug();
+                    }
+#line 1539 "y.tab.c"
+    break;
+
+  case 20: /* $@3: %empty  */
+#line 159 "amdasm.y"
+                        { ctx->vdef = new Def((yyvsp[-1].name)->text); }
+#line 1545 "y.tab.c"
+    break;
+
+  case 21: /* microword_stmt: label DEF $@3 fieldlist  */
+#line 160 "amdasm.y"
+                        { ctx->symtab->Enter(ctx->vdef);
+                      if (ctx->set->IsDebug(DBG_DEFS))
+                        ctx->vdef->Debug("DEF");
+                      if (ctx->vdef->Bitsize() != ctx->set->WordSize()) {
+                        yyerror("DEF size does not match WORD size");
+                        ctx->vdef->Debug("DEF");
+                        YYERROR; }
+                    }
+#line 1558 "y.tab.c"
+    break;
+
+  case 22: /* $@4: %empty  */
+#line 171 "amdasm.y"
+                        { ctx->vdef = new Sub((yyvsp[-1].name)->text); }
+#line 1564 "y.tab.c"
+    break;
+
+  case 23: /* subword_stmt: label SUB $@4 fieldlist  */
+#line 172 "amdasm.y"
+                        { ctx->symtab->Enter(ctx->vdef);
+                      if (ctx->set->IsDebug(DBG_DEFS))
+                        ctx->vdef->Debug("SUB");
+                    }
+#line 1573 "y.tab.c"
+    break;
+
+  case 24: /* label: LABEL  */
+#line 179 "amdasm.y"
+                            { (yyval.name) = (yyvsp[0].name); }
+#line 1579 "y.tab.c"
+    break;
+
+  case 25: /* label: ENTRY  */
+#line 180 "amdasm.y"
+                            { (yyval.name) = (yyvsp[0].name); }
+#line 1585 "y.tab.c"
+    break;
+
+  case 27: /* def_stmt: WORD NUMBER NL  */
+#line 186 "amdasm.y"
+                        { ctx->set->SetWordSize((yyvsp[-1].fdecl).value); }
+#line 1591 "y.tab.c"
+    break;
+
+  case 33: /* cols_extension: COLS cols_list  */
+#line 195 "amdasm.y"
+                    { int w = ctx->set->WordSize(), c = ctx->columns->Size();
+                      if (w != c) {
+                        yyerror("COLS size does not match WORD size");
+                        if (w>c) ctx->columns->AddColumn(w-c);
+                        YYERROR;
+                      }
+                    }
+#line 1603 "y.tab.c"
+    break;
+
+  case 34: /* cols_list: NUMBER  */
+#line 205 "amdasm.y"
+                            { ctx->columns->AddColumn((yyvsp[0].fdecl).value); }
+#line 1609 "y.tab.c"
+    break;
+
+  case 35: /* cols_list: NUMBER COMMA cols_list  */
+#line 206 "amdasm.y"
+                            { ctx->columns->AddColumn((yyvsp[-2].fdecl).value); }
+#line 1615 "y.tab.c"
+    break;
+
+  case 38: /* field: DCFIELD  */
+#line 215 "amdasm.y"
+                                        { if (!ctx->vdef->AddField(new Field((yyvsp[0].fdecl)))) YYERROR; }
+#line 1621 "y.tab.c"
+    break;
+
+  case 39: /* $@5: %empty  */
+#line 216 "amdasm.y"
+                                        { ctx->vdecl = (yyvsp[0].fdecl); }
+#line 1627 "y.tab.c"
+    break;
+
+  case 40: /* field: VARFIELD $@5 opt_vattr opt_defval  */
+#line 218 "amdasm.y"
+                                        { if (!ctx->vdef->AddField(new VField(ctx->vdecl))) YYERROR; }
+#line 1633 "y.tab.c"
+    break;
+
+  case 41: /* field: constant  */
+#line 219 "amdasm.y"
+                                        { ctx->vdecl = (yyvsp[0].fdecl);
+                          if (!(ctx->vdecl.fmt & F_MASK)) ctx->vdecl.fmt |= F_DEC;
+                          if (!ctx->vdef->AddField(new CField(ctx->vdecl))) YYERROR;
+                        }
+#line 1642 "y.tab.c"
+    break;
+
+  case 42: /* field: NAME  */
+#line 223 "amdasm.y"
+                                        { if (!ctx->vdef->Include((yyvsp[0].name))) YYERROR; }
+#line 1648 "y.tab.c"
+    break;
+
+  case 43: /* constant: NUMBER CONST  */
+#line 227 "amdasm.y"
+                                { (yyval.fdecl) = (yyvsp[0].fdecl); (yyval.fdecl).sz = (yyvsp[-1].fdecl).value; }
+#line 1654 "y.tab.c"
+    break;
+
+  case 44: /* constant: CONST  */
+#line 228 "amdasm.y"
+                                        { (yyval.fdecl) = (yyvsp[0].fdecl); }
+#line 1660 "y.tab.c"
+    break;
+
+  case 45: /* constant: NUMBER  */
+#line 229 "amdasm.y"
+                                        { (yyval.fdecl) = (yyvsp[0].fdecl); }
+#line 1666 "y.tab.c"
+    break;
+
+  case 46: /* expr: constant  */
+#line 233 "amdasm.y"
+                                        { (yyval.fdecl) = (yyvsp[0].fdecl); }
+#line 1672 "y.tab.c"
+    break;
+
+  case 47: /* expr: NAME  */
+#line 234 "amdasm.y"
+                                        { if (!CField::ResolveDecimal((yyvsp[0].name)->text, &(yyval.fdecl)) && 
+                              !ctx->symtab->LookupValue((yyvsp[0].name), &(yyval.fdecl))) YYERROR;
+                        }
+#line 1680 "y.tab.c"
+    break;
+
+  case 48: /* expr: DOLLAR  */
+#line 237 "amdasm.y"
+                                        { (yyval.fdecl).Set(F_DEC, 0, ctx->set->LocPtr()); }
+#line 1686 "y.tab.c"
+    break;
+
+  case 49: /* expr: expr PLUS expr  */
+#line 238 "amdasm.y"
+                                { (yyval.fdecl).value = (yyvsp[-2].fdecl).value + (yyvsp[0].fdecl).value; (yyval.fdecl).sz = 0; }
+#line 1692 "y.tab.c"
+    break;
+
+  case 50: /* expr: expr MINUS expr  */
+#line 239 "amdasm.y"
+                                { (yyval.fdecl).value = (yyvsp[-2].fdecl).value - (yyvsp[0].fdecl).value; (yyval.fdecl).sz = 0; }
+#line 1698 "y.tab.c"
+    break;
+
+  case 51: /* expr: expr TIMES expr  */
+#line 240 "amdasm.y"
+                                { (yyval.fdecl).value = (yyvsp[-2].fdecl).value * (yyvsp[0].fdecl).value; (yyval.fdecl).sz = 0; }
+#line 1704 "y.tab.c"
+    break;
+
+  case 52: /* expr: expr SLASH expr  */
+#line 241 "amdasm.y"
+                                { (yyval.fdecl).value = (yyvsp[-2].fdecl).value / (yyvsp[0].fdecl).value; (yyval.fdecl).sz = 0; }
+#line 1710 "y.tab.c"
+    break;
+
+  case 54: /* opt_vattr: opt_vattr PERCENT  */
+#line 246 "amdasm.y"
+                            { ctx->vdecl.fmt |= FA_RITE; }
+#line 1716 "y.tab.c"
+    break;
+
+  case 55: /* opt_vattr: opt_vattr TIMES  */
+#line 247 "amdasm.y"
+                                { ctx->vdecl.fmt |= FA_INV; }
+#line 1722 "y.tab.c"
+    break;
+
+  case 56: /* opt_vattr: opt_vattr MINUS  */
+#line 248 "amdasm.y"
+                                { ctx->vdecl.fmt |= FA_NEG; }
+#line 1728 "y.tab.c"
+    break;
+
+  case 57: /* opt_vattr: opt_vattr COLON  */
+#line 249 "amdasm.y"
+                                { ctx->vdecl.fmt |= FA_TRNC; }
+#line 1734 "y.tab.c"
+    break;
+
+  case 58: /* opt_vattr: opt_vattr DOLLAR  */
+#line 250 "amdasm.y"
+                                { ctx->vdecl.fmt |= FA_PAGE; }
+#line 1740 "y.tab.c"
+    break;
+
+  case 59: /* opt_vattr: opt_vattr XOPT  */
+#line 251 "amdasm.y"
+                                { ctx->vdecl.fmt |= FA_XINI; }
+#line 1746 "y.tab.c"
+    break;
+
+  case 61: /* opt_defval: DEFFMT opt_vmod  */
+#line 256 "amdasm.y"
+                            { ctx->vdecl.fmt |= (yyvsp[-1].fmt); }
+#line 1752 "y.tab.c"
+    break;
+
+  case 62: /* opt_defval: constant opt_vmod  */
+#line 257 "amdasm.y"
+                            { ctx->vdecl.value = (yyvsp[-1].fdecl).value; ctx->vdecl.fmt |= ((yyvsp[-1].fdecl).fmt|FA_VAL); }
+#line 1758 "y.tab.c"
+    break;
+
+  case 64: /* opt_vmod: opt_vmod PERCENT  */
+#line 262 "amdasm.y"
+                            { ctx->vdecl.fmt |= FM_RITE; }
+#line 1764 "y.tab.c"
+    break;
+
+  case 65: /* opt_vmod: opt_vmod TIMES  */
+#line 263 "amdasm.y"
+                            { ctx->vdecl.fmt |= FM_INV; }
+#line 1770 "y.tab.c"
+    break;
+
+  case 66: /* opt_vmod: opt_vmod MINUS  */
+#line 264 "amdasm.y"
+                            { ctx->vdecl.fmt |= FM_NEG; }
+#line 1776 "y.tab.c"
+    break;
+
+  case 67: /* opt_vmod: opt_vmod COLON  */
+#line 265 "amdasm.y"
+                            { ctx->vdecl.fmt |= FM_TRNC; }
+#line 1782 "y.tab.c"
+    break;
+
+  case 68: /* $@6: %empty  */
+#line 272 "amdasm.y"
+                            { ctx->set->ResetLocPtr(); }
+#line 1788 "y.tab.c"
+    break;
+
+  case 71: /* src_stmts1: src_stmts1 src_stmt1  */
+#line 278 "amdasm.y"
+                             { if (yychar == YYEMPTY) Chunk::Mark(ctx); }
+#line 1794 "y.tab.c"
+    break;
+
+  case 79: /* src_stmt1: ORG expr NL  */
+#line 289 "amdasm.y"
+                        { ctx->set->SetLocPtr((yyvsp[-1].fdecl).value); }
+#line 1800 "y.tab.c"
+    break;
+
+  case 80: /* src_stmt1: RES expr NL  */
+#line 290 "amdasm.y"
+                            { ctx->set->IncLocPtr((yyvsp[-1].fdecl).value); }
+#line 1806 "y.tab.c"
+    break;
+
+  case 81: /* src_stmt1: ALIGN expr NL  */
+#line 291 "amdasm.y"
+                            { ctx->set->AlignLocPtr((yyvsp[-1].fdecl).value); }
+#line 1812 "y.tab.c"
+    break;
+
+  case 82: /* src_stmt1: opt_label1 exec_stmt1 NL  */
+#line 293 "amdasm.y"
+                        { ctx->set->IncLocPtr(1); }
+#line 1818 "y.tab.c"
+    break;
+
+  case 83: /* label1: LABEL  */
+#line 297 "amdasm.y"
+                                { ctx->labels->Enter(new Label((yyvsp[0].name)->text, ctx->set->LocPtr(), false)); }
+#line 1824 "y.tab.c"
+    break;
+
+  case 84: /* label1: ENTRY  */
+#line 298 "amdasm.y"
+                                { ctx->labels->Enter(new Label((yyvsp[0].name)->text, ctx->set->LocPtr(), true)); }
+#line 1830 "y.tab.c"
+    break;
+
+  case 87: /* equ_stmt1: label EQU expr  */
+#line 307 "amdasm.y"
+                            { Equ* vequ = new Equ((yyvsp[-2].name)->text, (yyvsp[0].fdecl));
+                          ctx->symtab->Enter(vequ);
+                          if (ctx->set->IsDebug(DBG_DEFS))
+                            vequ->Debug();
+                        }
+#line 1840 "y.tab.c"
+    break;
+
+  case 110: /* $@7: %empty  */
+#line 361 "amdasm.y"
+                            { ctx->outline = 0; }
+#line 1846 "y.tab.c"
+    break;
+
+  case 111: /* $@8: %empty  */
+#line 363 "amdasm.y"
+                            { if (ctx->set->SinglePass()) Fixup::ResolveAll(); }
+#line 1852 "y.tab.c"
+    break;
+
+  case 117: /* src_stmt2: ORG expr NL  */
+#line 375 "amdasm.y"
+                        { ctx->set->SetLocPtr((yyvsp[-1].fdecl).value); }
+#line 1858 "y.tab.c"
+    break;
+
+  case 118: /* src_stmt2: RES expr NL  */
+#line 376 "amdasm.y"
+                            { ctx->set->IncLocPtr((yyvsp[-1].fdecl).value); }
+#line 1864 "y.tab.c"
+    break;
+
+  case 119: /* src_stmt2: ALIGN expr NL  */
+#line 377 "amdasm.y"
+                            { ctx->set->AlignLocPtr((yyvsp[-1].fdecl).value); }
+#line 1870 "y.tab.c"
+    break;
+
+  case 120: /* src_stmt2: opt_label2 exec_stmt NL  */
+#line 378 "amdasm.y"
+                                { ctx->set->IncLocPtr(1); }
+#line 1876 "y.tab.c"
+    break;
+
+  case 121: /* equ_stmt2: label EQU expr2  */
+#line 382 "amdasm.y"
+                            { if (ctx->set->SinglePass())
+                            enter_equ(ctx, (yyvsp[-2].name), (yyvsp[0].fdecl));
+                          else if (ctx->symtab->LookupValue((yyvsp[-2].name), &ctx->vdecl)) {
+                            if (ctx->vdecl.value != (yyvsp[0].fdecl).value)
+                              yyerror("Symbol value changed between phases");
+                          }
+                        }
+#line 1888 "y.tab.c"
+    break;
+
+  case 122: /* label2: LABEL  */
+#line 392 "amdasm.y"
+                                { if (ctx->set->SinglePass()) enter_label(ctx, (yyvsp[0].name), false); }
+#line 1894 "y.tab.c"
+    break;
+
+  case 123: /* label2: ENTRY  */
+#line 393 "amdasm.y"
+                                { if (ctx->set->SinglePass()) enter_label(ctx, (yyvsp[0].name), true); }
+#line 1900 "y.tab.c"
+    break;
+
+  case 126: /* $@9: %empty  */
+#line 402 "amdasm.y"
+                            { ctx->outline = new Lineout(); ctx->ffcnt = 0; }
+#line 1906 "y.tab.c"
+    break;
+
+  case 127: /* exec_stmt: FF $@9 fffieldlist2  */
+#line 403 "amdasm.y"
+                        { if (ctx->ffcnt != ctx->set->WordSize())
+                            yyerror("FF length does not match WORD size");
+                          ctx->outline = 0;
+                          Output::Stream();
+                        }
+#line 1916 "y.tab.c"
+    break;
+
+  case 128: /* exec_stmt: overlayformat_list2  */
+#line 408 "amdasm.y"
+                            { ctx->outline = 0; Output::Stream(); }
+#line 1922 "y.tab.c"
+    break;
+
+  case 131: /* fffield2: DCFIELD  */
+#line 417 "amdasm.y"
+                                        { if (!ctx->outline->SubstDC((yyvsp[0].fdecl), ctx->ffcnt)) YYERROR;
+                          ctx->ffcnt += (yyvsp[0].fdecl).sz;
+                        }
+#line 1930 "y.tab.c"
+    break;
+
+  case 132: /* $@10: %empty  */
+#line 420 "amdasm.y"
+                        { if (CField::ResolveDecimal((yyvsp[-1].name)->text, &ctx->vdecl))
+                            ctx->vsize = ctx->vdecl.value;
+                          else YYERROR;
+                        }
+#line 1939 "y.tab.c"
+    break;
+
+  case 133: /* fffield2: NAME LPAREN $@10 expr2 RPAREN  */
+#line 424 "amdasm.y"
+                        { (yyvsp[-1].fdecl).sz = ctx->vsize;
+                          if ((yyvsp[-1].fdecl).fmt & F_FWD) {
+                            if (!ctx->outline->DeferField(ctx->fwdname, (yyvsp[-1].fdecl), ctx->ffcnt)) YYERROR;
+                          } else if (!ctx->outline->SubstField((yyvsp[-1].fdecl), ctx->ffcnt)) YYERROR;
+                          ctx->ffcnt += ctx->vsize;
+                        }
+#line 1950 "y.tab.c"
+    break;
+
+  case 134: /* fffield2: constant  */
+#line 430 "amdasm.y"
+                                        { if ((yyvsp[0].fdecl).sz == 0) {
+                            yyerror("Size of constant undefined"); YYERROR;
+                          }
+                          if (!ctx->outline->SubstField((yyvsp[0].fdecl), ctx->ffcnt)) YYERROR;
+                          ctx->ffcnt += (yyvsp[0].fdecl).sz;
+                        }
+#line 1961 "y.tab.c"
+    break;
+
+  case 135: /* fffield2: NAME  */
+#line 436 "amdasm.y"
+                                        { if (Fixup::IsForward((yyvsp[0].name))) {
+                            yyerror("Forward reference requires size in single pass mode");
+                            YYERROR;
+                          }
+                          if (CField::ResolveDecimal((yyvsp[0].name)->text, &ctx->vdecl) ||
+                              ctx->symtab->LookupValue((yyvsp[0].name), &ctx->vdecl, true) ||
+                              ctx->labels->LookupValue((yyvsp[0].name), &ctx->vdecl, false)) {
+                            if (!ctx->outline->SubstField(ctx->vdecl, ctx->ffcnt)) YYERROR;
+                            ctx->ffcnt += ctx->vdecl.sz;
+                          } else YYERROR;
+                        }
+#line 1977 "y.tab.c"
+    break;
+
+  case 136: /* $@11: %empty  */
+#line 447 "amdasm.y"
+                        { if (ctx->Worker()) ctx->failed = true; }
+#line 1983 "y.tab.c"
+    break;
+
+  case 138: /* $@12: %empty  */
+#line 452 "amdasm.y"
+                            { if (ctx->outline == 0) ctx->outline = new Lineout(); 
+                          ctx->outline->SetOverlayFormat((yyvsp[0].name));
+                        }
+#line 1991 "y.tab.c"
+    break;
+
+  case 140: /* overlayformat_list2: overlayformat2  */
+#line 459 "amdasm.y"
+                            { ctx->outline->DebugSubst(SUB_CURMAP); }
+#line 1997 "y.tab.c"
+    break;
+
+  case 141: /* overlayformat_list2: overlayformat_list2 AMPERSAND overlayformat2  */
+#line 460 "amdasm.y"
+                                                     { ctx->outline->DebugSubst(SUB_CURMAP); }
+#line 2003 "y.tab.c"
+    break;
+
+  case 142: /* opt_vfslist2: %empty  */
+#line 464 "amdasm.y"
+                            { ctx->outline->SkipArg(); }
+#line 2009 "y.tab.c"
+    break;
+
+  case 143: /* opt_vfslist2: expr2  */
+#line 465 "amdasm.y"
+                            { subst_arg(ctx, (yyvsp[0].fdecl)); }
+#line 2015 "y.tab.c"
+    break;
+
+  case 144: /* opt_vfslist2: opt_vfslist2 COMMA expr2  */
+#line 466 "amdasm.y"
+                                 { subst_arg(ctx, (yyvsp[0].fdecl)); }
+#line 2021 "y.tab.c"
+    break;
+
+  case 145: /* opt_vfslist2: opt_vfslist2 COMMA  */
+#line 467 "amdasm.y"
+                            { ctx->outline->SkipArg(); }
+#line 2027 "y.tab.c"
+    break;
+
+  case 146: /* expr2: constant  */
+#line 471 "amdasm.y"
+                            { (yyval.fdecl) = (yyvsp[0].fdecl); }
+#line 2033 "y.tab.c"
+    break;
+
+  case 147: /* expr2: NAME  */
+#line 472 "amdasm.y"
+                                        { if (CField::ResolveDecimal((yyvsp[0].name)->text, &(yyval.fdecl)))
+                            ;
+                          else if (!ctx->outline && ctx->set->SinglePass()) {
+                            /* EQU: resolve like phase 2a */
+                            if (!ctx->symtab->LookupValue((yyvsp[0].name), &(yyval.fdecl))) YYERROR;
+                          } else if (Fixup::IsForward((yyvsp[0].name))) {
+                            /* before the lookahead may flush the line */
+                            ctx->fwdname = (yyvsp[0].name);
+                            ctx->fwdline = ctx->p->Lineno();
+                            delete[] ctx->fwdtext;
+                            ctx->fwdtext = copystr(ctx->p->Linebuf());
+                            (yyval.fdecl).Set(F_FWD, 0, 0);
+                          } else
+                            ctx->outline->GetNameArg((yyvsp[0].name), &(yyval.fdecl));
+                        }
+#line 2053 "y.tab.c"
+    break;
+
+  case 148: /* expr2: DOLLAR  */
+#line 487 "amdasm.y"
+                                        { (yyval.fdecl).Set(F_DEC, 0, ctx->outline ? ctx->outline->LocPtr() : ctx->set->LocPtr()); }
+#line 2059 "y.tab.c"
+    break;
+
+  case 149: /* expr2: expr2 PLUS expr2  */
+#line 488 "amdasm.y"
+                                { (yyval.fdecl).Set(F_DEC|fwd_expr((yyvsp[-2].fdecl), (yyvsp[0].fdecl), true, true), 0, (yyvsp[-2].fdecl).value + (yyvsp[0].fdecl).value); }
+#line 2065 "y.tab.c"
+    break;
+
+  case 150: /* expr2: expr2 MINUS expr2  */
+#line 489 "amdasm.y"
+                                { (yyval.fdecl).Set(F_DEC|fwd_expr((yyvsp[-2].fdecl), (yyvsp[0].fdecl), true, false), 0, (yyvsp[-2].fdecl).value - (yyvsp[0].fdecl).value); }
+#line 2071 "y.tab.c"
+    break;
+
+  case 151: /* expr2: expr2 TIMES expr2  */
+#line 490 "amdasm.y"
+                                { (yyval.fdecl).Set(F_DEC|fwd_expr((yyvsp[-2].fdecl), (yyvsp[0].fdecl), false, false), 0, (yyvsp[-2].fdecl).value * (yyvsp[0].fdecl).value); }
+#line 2077 "y.tab.c"
+    break;
+
+  case 152: /* expr2: expr2 SLASH expr2  */
+#line 491 "amdasm.y"
+                                { (yyval.fdecl).Set(F_DEC|fwd_expr((yyvsp[-2].fdecl), (yyvsp[0].fdecl), false, false), 0, (yyvsp[-2].fdecl).value / (yyvsp[0].fdecl).value); }
+#line 2083 "y.tab.c"
+    break;
+
+
+#line 2087 "y.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (ctx, YY_("syntax error"));
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, ctx);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, ctx);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (ctx, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, ctx);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, ctx);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 494 "amdasm.y"
+
@@ -0,0 +1,139 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_Y_TAB_H_INCLUDED
+# define YY_YY_Y_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 1
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+/* "%code requires" blocks.  */
+#line 74 "amdasm.y"
+
+class Context;
+struct Ident;
+
+#line 54 "y.tab.h"
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    NL = 258,                      /* NL  */
+    CONST = 259,                   /* CONST  */
+    NUMBER = 260,                  /* NUMBER  */
+    DCFIELD = 261,                 /* DCFIELD  */
+    VARFIELD = 262,                /* VARFIELD  */
+    ALIGN = 263,                   /* ALIGN  */
+    EJECT = 264,                   /* EJECT  */
+    END = 265,                     /* END  */
+    EQU = 266,                     /* EQU  */
+    FF = 267,                      /* FF  */
+    LIST = 268,                    /* LIST  */
+    NOLIST = 269,                  /* NOLIST  */
+    ORG = 270,                     /* ORG  */
+    RES = 271,                     /* RES  */
+    SPACE = 272,                   /* SPACE  */
+    DEFFMT = 273,                  /* DEFFMT  */
+    TITLE = 274,                   /* TITLE  */
+    DEF = 275,                     /* DEF  */
+    SUB = 276,                     /* SUB  */
+    XOPT = 277,                    /* XOPT  */
+    WORD = 278,                    /* WORD  */
+    NAME = 279,                    /* NAME  */
+    ENTRY = 280,                   /* ENTRY  */
+    LABEL = 281,                   /* LABEL  */
+    COMMA = 282,                   /* COMMA  */
+    AMPERSAND = 283,               /* AMPERSAND  */
+    COLON = 284,                   /* COLON  */
+    PERCENT = 285,                 /* PERCENT  */
+    DOLLAR = 286,                  /* DOLLAR  */
+    LPAREN = 287,                  /* LPAREN  */
+    RPAREN = 288,                  /* RPAREN  */
+    DEFMARK = 289,                 /* DEFMARK  */
+    SRCMARK1 = 290,                /* SRCMARK1  */
+    SRCMARK2 = 291,                /* SRCMARK2  */
+    SRCCHUNK = 292,                /* SRCCHUNK  */
+    COLS = 293,                    /* COLS  */
+    PLUS = 294,                    /* PLUS  */
+    MINUS = 295,                   /* MINUS  */
+    TIMES = 296,                   /* TIMES  */
+    SLASH = 297                    /* SLASH  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 84 "amdasm.y"
+
+	int   fmt;
+	char* str;
+	const Ident* name;
+	Fdecl fdecl;
+
+#line 120 "y.tab.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+
+
+int yyparse (Context* ctx);
+
+/* "%code provides" blocks.  */
+#line 79 "amdasm.y"
+
+extern int yylex(YYSTYPE* lval, Context* ctx);
+
+#line 138 "y.tab.h"
+
+#endif /* !YY_YY_Y_TAB_H_INCLUDED  */